@@ -40,12 +40,14 @@ class LbotConan(ConanFile):
     options = {
         "system_deps": [True, False],
         "shared": [True, False],
-        "plugins": [True, False]
+        "plugins": [True, False],
+        "tracing": [True, False]
     }
     default_options = {
         "system_deps": False,
         "shared": False,
-        "plugins": True
+        "plugins": True,
+        "tracing": False
     }
 
     @property
@@ -133,6 +135,7 @@ class LbotConan(ConanFile):
         toolchain.variables["GIT_REF"] = version_data["ref"]
         toolchain.variables["GIT_BRANCH"] = version_data["branch"]
         toolchain.variables["LBOT_ENABLE_PLUGINS"] = self.options.plugins
+        toolchain.variables["LBOT_ENABLE_TRACING"] = self.options.tracing
         toolchain.generate()
 
     def export(self):
@@ -161,6 +164,10 @@ class LbotConan(ConanFile):
         self.cpp_info.components["core"].libs = ["lbot_core"]
         self.cpp_info.components["core"].requires = ["flatbuffers::flatbuffers", "yaml-cpp::yaml-cpp"]
 
+        # The layout of messages depends on whether tracing is enabled.
+        if self.options.tracing:
+            self.cpp_info.components["core"].defines = ["LBOT_ENABLE_TRACING"]
+
         if self.options.plugins:
             self.cpp_info.components["plugins"].set_property("cmake_target_name", f"{self.name}::plugins")
             self.cpp_info.components["plugins"].set_property("cmake_module_target_name", f"{self.name}::plugins")
@@ -0,0 +1,168 @@
+/**
+ * @file delivery.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/delivery.hpp>
+#include <labrat/lbot/exception.hpp>
+
+#include <utility>
+
+inline namespace labrat {
+namespace lbot {
+
+PluginQueue::PluginQueue(const TopicMap::PluginCallback &callback, const DeliveryPolicy &policy, const std::string &name) :
+  callback(callback),
+  policy(policy),
+  head(0),
+  size(0),
+  stopping(false),
+  dropped_count(0)
+{
+  if (policy.queue_size == 0) {
+    throw InvalidArgumentException("The queue size of a plugin queue must not be zero.");
+  }
+
+  entries.resize(policy.queue_size);
+
+  thread = LoopThread(&PluginQueue::deliverLoop, "plugin " + name, 1, this);
+}
+
+PluginQueue::~PluginQueue()
+{
+  {
+    std::unique_lock lock(mutex);
+
+    // The plugin has already been removed from all topics, so that the queue will only shrink. Queued messages are delivered before the
+    // thread is stopped.
+    empty_condition.wait(lock, [this]() {
+      return size == 0;
+    });
+
+    stopping = true;
+  }
+
+  filled_condition.notify_all();
+  space_condition.notify_all();
+
+  thread.stop();
+}
+
+void PluginQueue::enqueue(void *queue, const MessageInfo &info)
+{
+  reinterpret_cast<PluginQueue *>(queue)->push(info);
+}
+
+void PluginQueue::push(const MessageInfo &info)
+{
+  std::unique_lock lock(mutex);
+
+  if (size == entries.size()) {
+    switch (policy.queue_policy) {
+      case QueuePolicy::overwrite_oldest: {
+        head = (head + 1) % entries.size();
+        --size;
+
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+
+      case QueuePolicy::drop_newest: {
+        dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+
+      case QueuePolicy::block_sender: {
+        const auto has_space = [this]() {
+          return size != entries.size() || stopping;
+        };
+
+        if (policy.block_timeout == std::chrono::nanoseconds::zero()) {
+          space_condition.wait(lock, has_space);
+        } else if (!space_condition.wait_for(lock, policy.block_timeout, has_space)) {
+          dropped_count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+
+        if (stopping) {
+          dropped_count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+
+        break;
+      }
+    }
+  }
+
+  Entry &entry = entries[(head + size) % entries.size()];
+  entry.topic_info = getTopicInfo(info.topic_info);
+  entry.timestamp = info.timestamp;
+
+  // The buffer keeps its capacity, so that it only has to be allocated once.
+  entry.buffer.assign(info.serialized_message.begin(), info.serialized_message.end());
+
+  ++size;
+
+  lock.unlock();
+  filled_condition.notify_one();
+}
+
+void PluginQueue::deliverLoop()
+{
+  const TopicInfo *topic_info;
+  Clock::time_point timestamp;
+
+  {
+    std::unique_lock lock(mutex);
+
+    filled_condition.wait(lock, [this]() {
+      return size != 0 || stopping;
+    });
+
+    // Remaining messages are still delivered when the queue is stopped.
+    if (size == 0) {
+      return;
+    }
+
+    Entry &front = entries[head];
+    topic_info = front.topic_info;
+    timestamp = front.timestamp;
+
+    // Swap the buffers, so that the buffer of the previous message is reused by the queue.
+    std::swap(delivery_buffer, front.buffer);
+
+    head = (head + 1) % entries.size();
+    --size;
+
+    if (size == 0) {
+      empty_condition.notify_all();
+    }
+  }
+
+  space_condition.notify_one();
+
+  const MessageInfo info = {
+    .topic_info = *topic_info,
+    .timestamp = timestamp,
+    .serialized_message = flatbuffers::span<u8>(delivery_buffer.data(), delivery_buffer.size())
+  };
+
+  callback.function(callback.user_ptr, info);
+}
+
+const TopicInfo *PluginQueue::getTopicInfo(const TopicInfo &topic_info)
+{
+  std::unique_ptr<const TopicInfo> &result = topic_infos[topic_info.topic_hash];
+
+  if (!result) {
+    result = std::make_unique<const TopicInfo>(topic_info);
+  }
+
+  return result.get();
+}
+
+}  // namespace lbot
+}  // namespace labrat
@@ -0,0 +1,157 @@
+/**
+ * @file delivery.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/info.hpp>
+#include <labrat/lbot/topic.hpp>
+#include <labrat/lbot/utils/thread.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+
+/**
+ * @brief Policy to control how a receiver handles new messages when its consumer falls behind.
+ *
+ */
+enum class QueuePolicy
+{
+  /** New messages overwrite the oldest messages in the buffer. A call to next() will yield the newest message. */
+  overwrite_oldest,
+  /** New messages are dropped while the buffer is full. A call to next() will yield the oldest unread message. */
+  drop_newest,
+  /** The sender is blocked while the buffer is full. Messages are dropped once the timeout has been exceeded. A call to next() will yield the
+   * oldest unread message. */
+  block_sender,
+};
+
+/**
+ * @brief Settings on how messages are delivered to a plugin.
+ * @details By default, the message callback of a plugin is called on the publishing thread. With a non-zero queue size, the publisher only
+ * copies the serialized message into a bounded queue and a dedicated thread of the plugin calls the message callback, so that a slow plugin
+ * does not delay the publisher.
+ *
+ */
+struct DeliveryPolicy
+{
+  /** Number of messages that can be queued. A size of zero delivers messages synchronously on the publishing thread. */
+  std::size_t queue_size = 0;
+  /** Policy to handle new messages while the queue is full. */
+  QueuePolicy queue_policy = QueuePolicy::drop_newest;
+  /** Maximum duration a publisher will be blocked when using QueuePolicy::block_sender. A duration of zero will block indefinitely. */
+  std::chrono::nanoseconds block_timeout = std::chrono::nanoseconds::zero();
+};
+
+/** @cond INTERNAL */
+/**
+ * @brief Bounded queue to deliver messages to a plugin on a dedicated thread.
+ * The serialized messages are copied into buffers owned by the queue, which are reused once the messages have been delivered.
+ *
+ */
+class PluginQueue final
+{
+public:
+  /**
+   * @brief Construct a new Plugin Queue object and start its delivery thread.
+   *
+   * @param callback Message callback of the plugin.
+   * @param policy Delivery policy of the plugin.
+   * @param name Name of the plugin.
+   * @throw InvalidArgumentException When the queue size of the policy is zero.
+   */
+  PluginQueue(const TopicMap::PluginCallback &callback, const DeliveryPolicy &policy, const std::string &name);
+  PluginQueue(const PluginQueue &) = delete;
+
+  /**
+   * @brief Deliver the remaining messages and stop the delivery thread.
+   * The queue must already have been removed from all topics.
+   *
+   */
+  ~PluginQueue();
+
+  /**
+   * @brief Get the callback to be registered with the topics instead of the message callback of the plugin.
+   *
+   * @return TopicMap::PluginCallback Callback enqueuing the messages.
+   */
+  [[nodiscard]] inline TopicMap::PluginCallback getCallback()
+  {
+    return TopicMap::PluginCallback{.user_ptr = this, .function = &PluginQueue::enqueue};
+  }
+
+  /**
+   * @brief Get the number of messages that have been dropped due to the queue being full.
+   *
+   * @return std::size_t Number of dropped messages.
+   */
+  [[nodiscard]] inline std::size_t getDroppedCount() const
+  {
+    return dropped_count.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Entry
+  {
+    const TopicInfo *topic_info;
+    Clock::time_point timestamp;
+    std::vector<u8> buffer;
+  };
+
+  static void enqueue(void *queue, const MessageInfo &info);
+
+  void push(const MessageInfo &info);
+  void deliverLoop();
+
+  /**
+   * @brief Get a copy of the topic info owned by the queue, as senders might be destroyed before their messages have been delivered.
+   *
+   * @param topic_info Topic info provided by the sender.
+   * @return const TopicInfo* Copy of the topic info.
+   */
+  const TopicInfo *getTopicInfo(const TopicInfo &topic_info);
+
+  const TopicMap::PluginCallback callback;
+  const DeliveryPolicy policy;
+
+  std::mutex mutex;
+  std::condition_variable filled_condition;
+  std::condition_variable space_condition;
+  std::condition_variable empty_condition;
+
+  std::vector<Entry> entries;
+  std::vector<u8> delivery_buffer;
+  std::size_t head;
+  std::size_t size;
+  bool stopping;
+
+  std::unordered_map<std::size_t, std::unique_ptr<const TopicInfo>> topic_infos;
+
+  std::atomic<std::size_t> dropped_count;
+
+  LoopThread thread;
+};
+/** @endcond */
+
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
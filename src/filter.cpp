@@ -0,0 +1,106 @@
+/**
+ * @file filter.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/filter.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+inline namespace labrat {
+namespace lbot {
+
+/**
+ * @brief Match a topic name against a glob pattern.
+ *
+ * @param pattern Remaining part of the pattern.
+ * @param name Remaining part of the topic name.
+ * @return true When the name matches the pattern.
+ */
+static bool matchGlob(std::string_view pattern, std::string_view name)
+{
+  while (!pattern.empty()) {
+    if (pattern.starts_with("**")) {
+      pattern.remove_prefix(2);
+
+      for (std::size_t i = 0; i <= name.size(); ++i) {
+        if (matchGlob(pattern, name.substr(i))) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    if (pattern.front() == '*') {
+      pattern.remove_prefix(1);
+
+      for (std::size_t i = 0;; ++i) {
+        if (matchGlob(pattern, name.substr(i))) {
+          return true;
+        }
+
+        // A single wildcard does not cross a level of the topic name.
+        if (i == name.size() || name[i] == '/') {
+          return false;
+        }
+      }
+    }
+
+    if (name.empty()) {
+      return false;
+    }
+
+    if (pattern.front() == '?') {
+      if (name.front() == '/') {
+        return false;
+      }
+    } else if (pattern.front() != name.front()) {
+      return false;
+    }
+
+    pattern.remove_prefix(1);
+    name.remove_prefix(1);
+  }
+
+  return name.empty();
+}
+
+void Filter::addPattern(const std::string &pattern)
+{
+  const std::size_t wildcard = pattern.find_first_of("*?");
+
+  if (wildcard == std::string::npos) {
+    set.emplace(std::hash<std::string>()(pattern));
+    return;
+  }
+
+  if (wildcard == pattern.size() - 2 && pattern.ends_with("**")) {
+    patterns.emplace_back(Pattern{.type = Pattern::Type::prefix, .text = pattern.substr(0, wildcard)});
+    return;
+  }
+
+  patterns.emplace_back(Pattern{.type = Pattern::Type::glob, .text = pattern});
+}
+
+bool Filter::matchPatterns(const std::string &topic_name) const
+{
+  return std::any_of(patterns.begin(), patterns.end(), [&topic_name](const Pattern &pattern) {
+    switch (pattern.type) {
+      case Pattern::Type::prefix:
+        return topic_name.starts_with(pattern.text);
+
+      case Pattern::Type::glob:
+        return matchGlob(pattern.text, topic_name);
+    }
+
+    return false;
+  });
+}
+
+}  // namespace lbot
+}  // namespace labrat
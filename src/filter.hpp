@@ -12,12 +12,19 @@
 
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 /** @cond INTERNAL */
 inline namespace labrat {
 /** @endcond */
 namespace lbot {
 
+/**
+ * @brief Filter to control which topics and services are passed onto a plugin.
+ * @details Topics can either be specified by their exact name or by a pattern. Patterns are evaluated once when a topic is created, so that
+ * the filter does not affect the performance of sending out messages.
+ *
+ */
 class Filter
 {
 public:
@@ -25,6 +32,7 @@ public:
 
   /**
    * @brief Check whether a callback should be performed for the topic with the supplied hash code.
+   * Only topics that have been added by their exact name are considered.
    *
    * @param topic_hash Hash code of the topic.
    * @return true The callback should be performed.
@@ -36,7 +44,7 @@ public:
   }
 
   /**
-   * @brief Check whether a callback should be performed for the topic with the supplied hash code.
+   * @brief Check whether a callback should be performed for the topic with the supplied name.
    *
    * @param topic_name Name of the topic.
    * @return true The callback should be performed.
@@ -44,7 +52,7 @@ public:
    */
   inline bool check(const std::string &topic_name) const
   {
-    return check(std::hash<std::string>()(topic_name));
+    return (set.contains(std::hash<std::string>()(topic_name)) || matchPatterns(topic_name)) ^ mode;
   }
 
   /**
@@ -69,7 +77,48 @@ public:
     add<true>(std::hash<std::string>()(topic_name));
   }
 
+  /**
+   * @brief Whitelist all topics matching a pattern.
+   * All previously blacklisted topics will be removed from the filter.
+   * Within a pattern, '?' matches any single character except '/', '*' matches any sequence of characters except '/' and '**' matches any
+   * sequence of characters. For example, a pattern consisting of the prefix '/camera/' followed by '**' matches all topics below '/camera/'.
+   *
+   * @param pattern Pattern of the topic names.
+   */
+  inline void whitelistPattern(const std::string &pattern)
+  {
+    add<false>(pattern);
+  }
+
+  /**
+   * @brief Blacklist all topics matching a pattern.
+   * All previously whitelisted topics will be removed from the filter.
+   * The syntax of the pattern is the same as for whitelistPattern().
+   *
+   * @param pattern Pattern of the topic names.
+   */
+  inline void blacklistPattern(const std::string &pattern)
+  {
+    add<true>(pattern);
+  }
+
 private:
+  /**
+   * @brief Compiled pattern of topic names.
+   * Patterns consisting of a literal prefix followed by '**' are matched by comparing the prefix only.
+   *
+   */
+  struct Pattern
+  {
+    enum class Type
+    {
+      prefix,
+      glob,
+    } type;
+
+    std::string text;
+  };
+
   /**
    * @brief Add a topic to the filter.
    * Depending on the supplied mode this will either whitelist or blacklist the relevant topic.
@@ -81,15 +130,40 @@ private:
   template <bool Mode>
   void add(std::size_t topic_hash)
   {
-    if (mode != Mode) {
-      set.clear();
-      mode = Mode;
-    }
+    setMode(Mode);
 
     set.emplace(topic_hash);
   }
 
+  /**
+   * @brief Add a pattern to the filter.
+   * Patterns without wildcards are added as exact topic names.
+   *
+   * @tparam Mode New mode of the filter.
+   * @param pattern Pattern of the topic names.
+   */
+  template <bool Mode>
+  void add(const std::string &pattern)
+  {
+    setMode(Mode);
+
+    addPattern(pattern);
+  }
+
+  inline void setMode(bool new_mode)
+  {
+    if (mode != new_mode) {
+      set.clear();
+      patterns.clear();
+      mode = new_mode;
+    }
+  }
+
+  void addPattern(const std::string &pattern);
+  bool matchPatterns(const std::string &topic_name) const;
+
   std::unordered_set<std::size_t> set;
+  std::vector<Pattern> patterns;
 
   /**
    * @brief Mode of the filter.
@@ -7,10 +7,13 @@
  */
 
 #include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/config.hpp>
 #include <labrat/lbot/logger.hpp>
 #include <labrat/lbot/manager.hpp>
 #include <labrat/lbot/plugin.hpp>
+#include <labrat/lbot/statistics.hpp>
 #include <labrat/lbot/utils/atomic.hpp>
+#include <labrat/lbot/utils/executor.hpp>
 
 inline namespace labrat {
 namespace lbot {
@@ -27,8 +30,13 @@ Manager::~Manager()
 {
   topic_map.forceFlush();
 
+  Statistics::deinitialize(*this);
   Logger::deinitialize();
 
+  for (PluginRegistration &plugin : plugin_list) {
+    topic_map.removePlugin(plugin.getMessageCallback().user_ptr);
+  }
+
   {
     FlagGuard guard(plugin_update_flag);
     waitUntil(plugin_use_count, 0U);
@@ -37,6 +45,7 @@ Manager::~Manager()
 
   Clock::cleanup();
   node_map.clear();
+  executor.reset();
   Clock::deinitialize();
 
   instance_flag = false;
@@ -58,6 +67,7 @@ Manager::Ptr Manager::get()
   }
 
   Clock::initialize();
+  Statistics::initialize();
 
   return result;
 }
@@ -90,6 +100,8 @@ void Manager::removePluginInternal(const std::string &name)
 
   std::vector<std::shared_ptr<Node>> plugin_nodes;
 
+  topic_map.removePlugin(iterator->getMessageCallback().user_ptr);
+
   {
     FlagGuard guard(plugin_update_flag);
     waitUntil(plugin_use_count, 0U);
@@ -113,6 +125,21 @@ void Manager::removePluginInternal(const std::string &name)
   }
 }
 
+Executor &Manager::getExecutor()
+{
+  std::call_once(executor_flag, [this]() {
+    const int thread_count = Config::get()->getParameterFallback("/lbot/executor/thread_count", 0).get<int>();
+
+    if (thread_count < 0) {
+      throw InvalidArgumentException("The number of executor threads must not be negative.");
+    }
+
+    executor = std::make_unique<Executor>(thread_count, "executor");
+  });
+
+  return *executor;
+}
+
 void Manager::createNodeEnvironment(const std::string &name)
 {
   node_environment.emplace(NodeEnvironment{
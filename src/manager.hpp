@@ -9,6 +9,7 @@
 #pragma once
 
 #include <labrat/lbot/base.hpp>
+#include <labrat/lbot/delivery.hpp>
 #include <labrat/lbot/exception.hpp>
 #include <labrat/lbot/filter.hpp>
 #include <labrat/lbot/info.hpp>
@@ -22,6 +23,7 @@
 #include <concepts>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -41,6 +43,14 @@ class UniqueNode;
 class Plugin;
 class UniquePlugin;
 
+class Statistics;
+
+/** @cond INTERNAL */
+inline namespace utils {
+class Executor;
+}  // namespace utils
+/** @endcond */
+
 /** @cond INTERNAL */
 template <typename T>
 concept has_topic_callback = requires(T *self, const TopicInfo &info) {
@@ -109,9 +119,26 @@ private:
     void (*service_callback)(void *plugin, const ServiceInfo &info);
     void (*message_callback)(void *plugin, const MessageInfo &info);
 
+    // Declared after the plugin, so that the remaining messages are delivered before the plugin is destroyed.
+    std::unique_ptr<PluginQueue> queue;
+
     PluginRegistration(FinalPtr<Plugin> &&plugin) :
       plugin(std::forward<FinalPtr<Plugin>>(plugin))
     {}
+
+    /**
+     * @brief Get the message callback registered with the topics.
+     *
+     * @return TopicMap::PluginCallback Message callback of the plugin or of its delivery queue.
+     */
+    [[nodiscard]] inline TopicMap::PluginCallback getMessageCallback() const
+    {
+      if (queue) {
+        return queue->getCallback();
+      }
+
+      return TopicMap::PluginCallback{.user_ptr = user_ptr, .function = message_callback};
+    }
   };
 
   /**
@@ -188,6 +215,9 @@ private:
   std::atomic_flag plugin_update_flag;
   std::atomic<u32> plugin_use_count;
 
+  std::unique_ptr<Executor> executor;
+  std::once_flag executor_flag;
+
   static thread_local std::optional<NodeEnvironment> node_environment;
   static thread_local std::optional<PluginEnvironment> plugin_environment;
 
@@ -282,6 +312,25 @@ public:
   template <typename T, typename... Args>
   std::shared_ptr<T> addPlugin(std::string name, Filter filter, Args &&...args)
   requires std::is_base_of_v<Plugin, T>
+  {
+    return addPlugin<T>(std::move(name), std::move(filter), DeliveryPolicy(), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Construct and add a plugin to the internal network.
+   * With a non-zero queue size in the delivery policy, the message callback of the plugin is called from a dedicated thread instead of the
+   * publishing thread.
+   *
+   * @tparam T Type of the plugin to be added.
+   * @tparam Args Types of the arguments to be forwarded to the plugin specific constructor.
+   * @param filter Topic filter to be used on callbacks.
+   * @param delivery Policy on how messages are delivered to the plugin.
+   * @param args Arguments to be forwarded to the plugin specific constructor.
+   * @return std::shared_ptr<T> Pointer to the created plugin.
+   */
+  template <typename T, typename... Args>
+  std::shared_ptr<T> addPlugin(std::string name, Filter filter, DeliveryPolicy delivery, Args &&...args)
+  requires std::is_base_of_v<Plugin, T>
   {
     createPluginEnvironment(name);
 
@@ -334,8 +383,18 @@ public:
       registration.message_callback = nullptr;
     }
 
+    if (registration.message_callback != nullptr && delivery.queue_size != 0) {
+      registration.queue = std::make_unique<PluginQueue>(
+        TopicMap::PluginCallback{.user_ptr = registration.user_ptr, .function = registration.message_callback}, delivery, name
+      );
+    }
+
     plugin_list.emplace_back(std::move(registration));
 
+    if (plugin_list.back().message_callback != nullptr) {
+      topic_map.addPlugin(plugin_list.back().getMessageCallback(), plugin_list.back().filter);
+    }
+
     return result;
   }
 
@@ -365,6 +424,14 @@ public:
    */
   void flushAllTopics();
 
+  /**
+   * @brief Get the executor shared among all nodes.
+   * The executor is created upon first use. The number of its worker threads can be set with the '/lbot/executor/thread_count' parameter.
+   *
+   * @return Executor& Reference to the shared executor.
+   */
+  Executor &getExecutor();
+
 private:
   void removeNodeInternal(const std::string &handle);
   void removePluginInternal(const std::string &handle);
@@ -377,6 +444,7 @@ private:
 
   friend Node;
   friend Plugin;
+  friend Statistics;
 
   friend void labrat::lbot::test::lbotReset();
 };
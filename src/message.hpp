@@ -10,11 +10,14 @@
 
 #include <labrat/lbot/base.hpp>
 #include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/tracing.hpp>
 #include <labrat/lbot/utils/concepts.hpp>
 #include <labrat/lbot/utils/types.hpp>
 
 #include <chrono>
 #include <concepts>
+#include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -170,6 +173,8 @@ template <typename T, typename R = void>
 concept can_move_from = can_move_from_noptr<T> || can_move_from_ptr<T>;
 /** @endcond  */
 
+class Node;
+
 /**
  * @brief Abstract time class for Message.
  *
@@ -187,6 +192,17 @@ public:
     return lbot_message_base_timestamp;
   }
 
+  /**
+   * @brief Get the trace context of the object.
+   * The context is empty unless lbot has been built with the ENABLE_TRACING option.
+   *
+   * @return const TraceContext&
+   */
+  [[nodiscard]] inline const TraceContext &getTraceContext() const
+  {
+    return lbot_message_base_trace;
+  }
+
 protected:
   /**
    * @brief Construct a new Message Base object and set the timestamp to the current time.
@@ -210,11 +226,36 @@ protected:
   MessageTime(const MessageTime &rhs)
   {
     lbot_message_base_timestamp = rhs.lbot_message_base_timestamp;
+    lbot_message_base_trace = rhs.lbot_message_base_trace;
   }
 
 private:
+  /**
+   * @brief Set the timestamp of a message whose storage is being reused.
+   *
+   * @param timestamp Timestamp of the message
+   */
+  void setTimestamp(Clock::time_point timestamp)
+  {
+    lbot_message_base_timestamp = timestamp;
+  }
+
+  /**
+   * @brief Set the trace context of a message that is about to be sent.
+   *
+   * @param trace Trace context of the message
+   */
+  void setTraceContext(const TraceContext &trace)
+  {
+    lbot_message_base_trace = trace;
+  }
+
+  friend class Node;
+
   // Long name to make ambiguity less likely.
   Clock::time_point lbot_message_base_timestamp;
+  // Takes up no space when tracing is disabled.
+  [[no_unique_address]] TraceContext lbot_message_base_trace;
 };
 
 /** @cond INTERNAL */
@@ -405,8 +446,86 @@ public:
 /** @cond INTERNAL */
 template <typename T, typename Flatbuffer = T::Flatbuffer>
 concept is_standard_message = std::is_same_v<T, Message<Flatbuffer>>;
+
+template <typename T, typename Converted = T::Converted>
+concept is_trivial_message = is_message<T> && !is_const_message<T> && std::is_trivially_copyable_v<Converted>
+                          && std::is_default_constructible_v<Converted>;
 /** @endcond  */
 
+/**
+ * @brief Read-only view of a serialized flatbuffer message.
+ * @details The contents are accessed through the generated accessor table, so that the message never has to be unpacked. Copies of a view
+ * share the underlying buffer.
+ *
+ * @tparam FlatbufferType Type of the flatbuffer table.
+ */
+template <typename FlatbufferType>
+requires is_flatbuffer<FlatbufferType>
+class MessageView : public MessageTime
+{
+public:
+  using Flatbuffer = std::remove_const_t<FlatbufferType>;
+  using Buffer = std::shared_ptr<const flatbuffers::DetachedBuffer>;
+
+  /**
+   * @brief Construct an empty view.
+   *
+   */
+  MessageView() = default;
+
+  /**
+   * @brief Construct a new view of a serialized message.
+   *
+   * @param buffer Finished flatbuffer containing the message.
+   * @param timestamp Timestamp of the message.
+   */
+  MessageView(Buffer buffer, Clock::time_point timestamp) :
+    MessageTime(timestamp),
+    buffer(std::move(buffer))
+  {}
+
+  MessageView(const MessageView &rhs) = default;
+  MessageView &operator=(const MessageView &rhs) = default;
+
+  /**
+   * @brief Access the message through the generated accessor table.
+   *
+   * @return const Flatbuffer* Pointer to the root table of the message.
+   */
+  [[nodiscard]] inline const Flatbuffer *get() const
+  {
+    return flatbuffers::GetRoot<Flatbuffer>(buffer->data());
+  }
+
+  inline const Flatbuffer *operator->() const
+  {
+    return get();
+  }
+
+  /**
+   * @brief Get the serialized message.
+   *
+   * @return std::span<const u8> Serialized message.
+   */
+  [[nodiscard]] inline std::span<const u8> getBuffer() const
+  {
+    return std::span<const u8>(buffer->data(), buffer->size());
+  }
+
+  /**
+   * @brief Check whether the view refers to a message.
+   *
+   * @return true When the view refers to a message.
+   */
+  [[nodiscard]] inline bool valid() const
+  {
+    return static_cast<bool>(buffer);
+  }
+
+private:
+  Buffer buffer;
+};
+
 }  // namespace lbot
 /** @cond INTERNAL */
 }  // namespace labrat
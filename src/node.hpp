@@ -10,6 +10,7 @@
 
 #include <labrat/lbot/base.hpp>
 #include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/delivery.hpp>
 #include <labrat/lbot/exception.hpp>
 #include <labrat/lbot/logger.hpp>
 #include <labrat/lbot/manager.hpp>
@@ -17,17 +18,39 @@
 #include <labrat/lbot/plugin.hpp>
 #include <labrat/lbot/service.hpp>
 #include <labrat/lbot/topic.hpp>
+#include <labrat/lbot/tracing.hpp>
 #include <labrat/lbot/utils/async.hpp>
+#include <labrat/lbot/utils/builder.hpp>
+#include <labrat/lbot/utils/coroutine.hpp>
+#include <labrat/lbot/utils/epoch.hpp>
+#include <labrat/lbot/utils/executor.hpp>
 #include <labrat/lbot/utils/fifo.hpp>
+#include <labrat/lbot/utils/pool.hpp>
+#include <labrat/lbot/utils/seqlock.hpp>
 #include <labrat/lbot/utils/types.hpp>
+#include <labrat/lbot/waitset.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
 #include <vector>
 
 /** @cond INTERNAL */
@@ -37,6 +60,77 @@ namespace lbot {
 
 class Manager;
 
+/**
+ * @brief Policy to control how a sender distributes its messages among the receivers of a topic.
+ *
+ */
+enum class FanOutPolicy
+{
+  /** Every receiver is provided with its own converted copy of the message. Receivers may move the message out of their buffer when
+   * calling next(). This requires one storage object per receiver and message, which can be recycled with StoragePolicy::reuse. */
+  copy,
+  /** The message is converted only once per put operation and shared among all receivers. A receiver will only copy the message once it
+   * reads it. Preferred for large messages sent to multiple receivers. */
+  shared,
+};
+
+/**
+ * @brief Policy to control how a sender allocates the converted messages it sends out.
+ *
+ */
+enum class StoragePolicy
+{
+  /** Every message is converted into a newly allocated storage object. */
+  allocate,
+  /** Storage objects that are no longer referenced by any receiver are recycled for subsequent messages, so that buffers within the
+   * message keep their allocations. The conversion function must overwrite all fields of the message. Recycling does not allocate once
+   * the pool of the sender is warm, but acquiring and releasing a storage object each lock two uncontended mutexes. Preferred for large
+   * messages sent at a high rate. */
+  reuse,
+};
+
+/**
+ * @brief Policy to control whether other senders may send out messages over the same topic.
+ *
+ */
+enum class SenderPolicy
+{
+  /** The sender is the only sender of the topic. */
+  exclusive,
+  /** Multiple senders may send out messages over the topic concurrently. Messages are delivered to each receiver in a single order, which
+   * requires a small amount of synchronization per receiver. All senders of the topic must use this policy. */
+  shared,
+};
+
+/**
+ * @brief Limits on the rate at which a receiver accepts messages.
+ * @details Messages skipped by a receiver are neither converted nor stored for it. All limits that are set must be satisfied for a message
+ * to be accepted.
+ *
+ */
+struct RateLimit
+{
+  /** Only every n-th message sent over the topic is accepted. A value of zero or one accepts every message. */
+  std::size_t decimation = 1;
+  /** Minimum duration between two accepted messages. A duration of zero disables the limit. A batch counts as a single instant. */
+  std::chrono::nanoseconds min_interval = std::chrono::nanoseconds::zero();
+  /** Maximum number of accepted messages per second. A rate of zero disables the limit. A batch counts as a single instant. */
+  double max_rate = 0.0;
+};
+
+/**
+ * @brief Policy to control how a synchronizer matches messages of different topics.
+ *
+ */
+enum class SyncPolicy
+{
+  /** Only messages with identical timestamps are matched. */
+  exact,
+  /** Messages are matched when their timestamps lie within the maximum interval of the synchronizer. Each message is matched with the
+   * closest messages of the other topics. */
+  approximate,
+};
+
 /**
  * @brief Base class for all nodes. A node should perform a specific task within the application.
  *
@@ -57,6 +151,10 @@ public:
   requires is_message<MessageType>
   class SenderBase;
 
+  template <typename FlatbufferType>
+  requires is_flatbuffer<FlatbufferType>
+  class ViewReceiver;
+
   /**
    * @brief Generic sender to declare virtual functions for type specific receiver instances to define.
    * This allows access to sender objetcs without knowledge of the underlying message types.
@@ -88,6 +186,16 @@ public:
      */
     virtual void put(ConvertedType &&container) = 0;
 
+    /**
+     * @brief Send out multiple messages onto the topic at once.
+     * @details The receivers and plugins of the topic are only looked up once and each receiver is woken up only once for the whole batch.
+     * Receivers will observe the messages in order. All messages of a batch share a single timestamp, so that receivers with a minimum
+     * interval or a maximum rate accept at most the first message of each batch. Decimation is applied to every message.
+     *
+     * @param containers Objects containing the data to be sent out.
+     */
+    virtual void putBatch(std::span<const ConvertedType> containers) = 0;
+
     /**
      * @brief Flush all receivers of the relevant topic.
      * This will unblock any waiting receivers calling the next() function and will invalidate the data stored in their buffers.
@@ -153,23 +261,42 @@ public:
      * @param topic_name Name of the topic.
      * @param node Reference to the parent node.
      * @param user_ptr User pointer to be used by the conversion function.
+     * @param fan_out Policy to control how messages are distributed among the receivers of the topic.
+     * @param sender_policy Policy to control whether other senders may send out messages over the topic.
+     * @param storage_policy Policy to control whether storage objects are recycled.
      */
-    SenderBase(const std::string &topic_name, Node &node, void *user_ptr = nullptr)
+    SenderBase(
+      const std::string &topic_name,
+      Node &node,
+      void *user_ptr = nullptr,
+      FanOutPolicy fan_out = FanOutPolicy::copy,
+      SenderPolicy sender_policy = SenderPolicy::exclusive,
+      StoragePolicy storage_policy = StoragePolicy::allocate
+    )
     requires can_convert_from<MessageType>
       :
       GenericSender<Converted>(
         TopicInfo::get<MessageType>(topic_name),
-        node.environment.topic_map.addSender<MessageType>(topic_name, this),
+        node.environment.topic_map.getTopic<MessageType>(topic_name),
         node
       ),
-      user_ptr(user_ptr)
+      user_ptr(user_ptr),
+      fan_out(fan_out),
+      shared(sender_policy == SenderPolicy::shared),
+      storage_pool(storage_policy == StoragePolicy::reuse ? ObjectPool<Storage>::create(storage_pool_size) : nullptr)
     {
+      // Plugins are only notified about the topic once. Whether this is the first sender is decided while the sender is registered, so
+      // that concurrently constructed shared senders cannot both skip the notification.
+      if (!GenericSender<Converted>::topic.addSender(this, shared)) {
+        return;
+      }
+
       ConsumerGuard<u32> guard(
         GenericSender<Converted>::node.environment.plugin_use_count, GenericSender<Converted>::node.environment.plugin_update_flag
       );
 
       for (Manager::PluginRegistration &plugin : node.environment.plugin_list) {
-        if (!plugin.filter.check(GenericSender<Converted>::topic_info.topic_hash)) {
+        if (!plugin.filter.check(GenericSender<Converted>::topic_info.topic_name)) {
           continue;
         }
 
@@ -182,81 +309,116 @@ public:
     friend class Node;
 
     void *const user_ptr;
+    const FanOutPolicy fan_out;
+    const bool shared;
+
+    // Storage objects are returned to the pool once the last receiver has released them. Only a few are in flight for most topics.
+    static constexpr std::size_t storage_pool_size = 16;
+    const std::shared_ptr<ObjectPool<Storage>> storage_pool;
+
+    using Flatbuffer = typename Storage::Flatbuffer;
+    using View = MessageView<Flatbuffer>;
 
-  public:
     /**
-     * @brief Destroy the Sender object.
+     * @brief Create a new storage object from the provided container.
      *
+     * @param container Object containing the data to be converted.
+     * @param timestamp Timestamp of the message.
+     * @param trace_context Trace context of the message.
+     * @return std::shared_ptr<Storage> Converted storage object.
      */
-    ~SenderBase() override
+    std::shared_ptr<Storage> createStorage(const Converted &container, Clock::time_point timestamp, const TraceContext &trace_context)
     {
-      SenderBase::flush();
+      std::shared_ptr<Storage> result;
+
+      if (storage_pool) {
+        result = storage_pool->acquire(timestamp);
+        result->setTimestamp(timestamp);
+      } else {
+        result = std::make_shared<Storage>(timestamp);
+      }
+
+      Convert<MessageType::convertFrom>::call(container, *result, user_ptr);
+
+      // Messages converted by copying them would otherwise keep the context of the source.
+      result->setTraceContext(trace_context);
 
-      GenericSender<Converted>::node.environment.topic_map.removeSender(GenericSender<Converted>::topic.name, this);
+      return result;
     }
 
     /**
-     * @brief Send out a message onto the topic.
+     * @brief Serialize a converted message into a view to be shared among all view receivers and plugins.
      *
-     * @param container Object containing the data to be sent out.
+     * @param storage Converted message to be serialized.
+     * @return std::shared_ptr<const View> View of the serialized message.
      */
-    void put(const Converted &container) override
+    std::shared_ptr<const View> createView(const Storage &storage)
     {
-      const Clock::time_point now = Clock::now();
-
-      TopicMap::Topic::ReceiverList receiver_list = GenericSender<Converted>::topic.getReceivers();
-      TopicMap::Topic::ReceiverList const_receiver_list = GenericSender<Converted>::topic.getConstReceivers();
-
-      const std::size_t receiver_count = receiver_list.size() + const_receiver_list.size();
-      if (receiver_count != 0) {
-        Storage storage(now);
-        bool storage_initialized = false;
+      BuilderPool::Lease builder;
+      builder->Finish(MessageType::Content::TableType::Pack(*builder, &storage));
 
-        std::vector<std::future<void>> futures;
-        futures.reserve(receiver_count);
+      const std::size_t size = builder->GetSize();
 
-        for (TopicMap::Topic::ReceiverList *range : {&receiver_list, &const_receiver_list}) {
-          for (void *pointer : *range) {
-            Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
+      GenericSender<Converted>::topic.counters.countBytes(size);
 
-            if (receiver->callback.valid()) {
-              if (!storage_initialized) {
-                Convert<MessageType::convertFrom>::call(container, storage, user_ptr);
-                storage_initialized = true;
-              }
+      // The view outlives the builder, so the message is copied into a buffer of its exact size. Releasing the buffer of the builder
+      // instead would force the builder to grow a new buffer for every message.
+      u8 *data = flatbuffers::Allocate(nullptr, size);
+      std::memcpy(data, builder->GetBufferPointer(), size);
 
-              futures.emplace_back(std::async(receiver->callback_policy, [receiver, &storage]() -> void {
-                receiver->callback.call(storage, receiver->user_ptr, receiver->callback_ptr);
-              }));
-            }
-          }
-        }
+      return std::make_shared<const View>(
+        std::make_shared<const flatbuffers::DetachedBuffer>(nullptr, false, data, size, data, size), storage.getTimestamp()
+      );
+    }
 
-        for (void *pointer : receiver_list) {
-          Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
+    /**
+     * @brief Call the callback function of a receiver and account for its execution time.
+     *
+     * @tparam ReceiverType Type of the receiver.
+     * @param receiver Receiver whose callback is to be called.
+     * @param storage Message to be provided to the callback.
+     */
+    template <typename ReceiverType>
+    void invokeCallback(ReceiverType *receiver, const Storage &storage)
+    {
+      const Tracer::CallbackScope scope(storage.getTraceContext());
 
-          const std::size_t local_count = receiver->count.load(std::memory_order_relaxed) + 1;
-          const std::size_t index = local_count & receiver->index_mask;
+      // Callbacks are only timed while the statistics are enabled.
+      if (!TopicMap::Topic::Counters::enabled()) {
+        receiver->callback.call(storage, receiver->user_ptr, receiver->callback_ptr);
+        return;
+      }
 
-          {
-            std::lock_guard guard(receiver->message_buffer[index].mutex);
-            receiver->message_buffer[index].message = Storage(now);
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-            Convert<MessageType::convertFrom>::call(container, receiver->message_buffer[index].message, user_ptr);
-            receiver->message_buffer[index].update_flag = true;
-            receiver->count.store(local_count, std::memory_order_release);
-          }
+      receiver->callback.call(storage, receiver->user_ptr, receiver->callback_ptr);
 
-          receiver->flush_flag = false;
-          receiver->condition.notify_one();
-        }
+      GenericSender<Converted>::topic.counters.countCallback(std::chrono::steady_clock::now() - start);
+    }
 
-        for (std::future<void> &future : futures) {
-          future.get();
-        }
+  public:
+    /**
+     * @brief Destroy the Sender object.
+     *
+     */
+    ~SenderBase() override
+    {
+      // Data of the remaining senders of the topic stays valid.
+      if (GenericSender<Converted>::node.environment.topic_map.removeSender(GenericSender<Converted>::topic.name, this)) {
+        SenderBase::flush();
       }
+    }
+
+    /**
+     * @brief Send out a message onto the topic.
+     *
+     * @param container Object containing the data to be sent out.
+     */
+    void put(const Converted &container) override
+    {
+      const TopicMap::Topic::Consumers consumers = GenericSender<Converted>::topic.getConsumers();
 
-      trace(container);
+      putInternal(container, consumers);
     }
 
     /**
@@ -272,8 +434,16 @@ public:
       if constexpr (!can_move_from<MessageType>) {
         put(container);
       } else {
-        TopicMap::Topic::ReceiverList receiver_list = GenericSender<Converted>::topic.getReceivers();
-        TopicMap::Topic::ReceiverList const_receiver_list = GenericSender<Converted>::topic.getConstReceivers();
+        const TopicMap::Topic::Consumers consumers = GenericSender<Converted>::topic.getConsumers();
+        const std::vector<void *> &receiver_list = consumers.getReceivers();
+        const std::vector<void *> &const_receiver_list = consumers.getConstReceivers();
+        const std::vector<void *> &view_receiver_list = consumers.getViewReceivers();
+
+        // View receivers share the serialized message, which requires a copy of the container anyway.
+        if (view_receiver_list.size() != 0) {
+          putInternal(container, consumers);
+          return;
+        }
 
         std::size_t receive_count = receiver_list.size();
 
@@ -281,81 +451,72 @@ public:
           receive_count += 1;
         }
 
-        ConsumerGuard<u32> guard(
-          GenericSender<Converted>::node.environment.plugin_use_count, GenericSender<Converted>::node.environment.plugin_update_flag
-        );
-
-        const Manager::PluginRegistration::List::iterator plugin_end = GenericSender<Converted>::node.environment.plugin_list.end();
-        Manager::PluginRegistration::List::iterator plugin_iterator = plugin_end;
+        const std::vector<TopicMap::PluginCallback> &plugin_list = consumers.getPlugins();
 
-        std::size_t i = 0;
-        for (Manager::PluginRegistration::List::iterator iter = GenericSender<Converted>::node.environment.plugin_list.begin();
-             iter != plugin_end;
-             ++iter) {
-          Manager::PluginRegistration &plugin = *iter;
-
-          if (plugin.filter.check(GenericSender<Converted>::topic_info.topic_hash)) {
-            ++receive_count;
-            plugin_iterator = iter;
-          }
+        receive_count += plugin_list.size();
 
-          ++i;
+        if (receive_count > 1) {
+          putInternal(container, consumers);
+          return;
         }
 
-        if (receive_count != 1) {
-          if (receive_count > 1) {
-            put(container);
-          }
+        GenericSender<Converted>::topic.counters.countMessages(1);
 
+        if (receive_count == 0) {
           return;
         }
 
         const Clock::time_point now = Clock::now();
+        const TraceContext trace_context = Tracer::publish(GenericSender<Converted>::topic_info.topic_hash, now);
 
-        if (plugin_iterator == plugin_end) {
+        if (plugin_list.size() == 0) {
           if (receiver_list.size() != 0) {
             // Send to a receiver.
-            Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(*receiver_list.begin());
-
-            const std::size_t local_count = receiver->count.load(std::memory_order_relaxed) + 1;
-            const std::size_t index = local_count & receiver->index_mask;
-
-            {
-              std::lock_guard guard(receiver->message_buffer[index].mutex);
-              receiver->message_buffer[index].message = Storage(now);
+            Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(receiver_list.front());
 
-              Move<MessageType::moveFrom>::call(std::forward<Converted>(container), receiver->message_buffer[index].message, user_ptr);
+            if (!receiver->accept(now)) {
+              return;
+            }
 
-              if (receiver->callback.valid()) {
-                receiver->callback.call(receiver->message_buffer[index].message, receiver->user_ptr, receiver->callback_ptr);
-              }
+            std::shared_ptr<Storage> storage = std::make_shared<Storage>(now);
+            Move<MessageType::moveFrom>::call(std::forward<Converted>(container), *storage, user_ptr);
+            storage->setTraceContext(trace_context);
 
-              receiver->message_buffer[index].update_flag = true;
-              receiver->count.store(local_count, std::memory_order_release);
+            if (receiver->callback.valid()) {
+              invokeCallback(receiver, *storage);
             }
 
-            receiver->flush_flag = false;
-            receiver->condition.notify_one();
+            receiver->store(std::move(storage), shared);
           } else {
             Storage storage(now);
             Move<MessageType::moveFrom>::call(std::forward<Converted>(container), storage, user_ptr);
+            storage.setTraceContext(trace_context);
 
+            Executor::Group group;
             std::vector<std::future<void>> futures;
             futures.reserve(const_receiver_list.size());
 
             for (void *pointer : const_receiver_list) {
               Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
 
-              if (receiver->callback.valid()) {
-                futures.emplace_back(std::async(receiver->callback_policy, [receiver, &storage]() -> void {
-                  receiver->callback.call(storage, receiver->user_ptr, receiver->callback_ptr);
-                }));
+              if (receiver->accept(now) && receiver->callback.valid()) {
+                auto function = [this, receiver, &storage]() -> void {
+                  invokeCallback(receiver, storage);
+                };
+
+                if (receiver->callback_executor != nullptr) {
+                  receiver->callback_executor->submit(group, std::move(function));
+                } else {
+                  futures.emplace_back(std::async(receiver->callback_policy, std::move(function)));
+                }
               }
             }
 
             for (std::future<void> &future : futures) {
               future.get();
             }
+
+            group.wait();
           }
         } else {
           // Send to a plugin.
@@ -363,628 +524,2561 @@ public:
 
           Move<MessageType::moveFrom>::call(std::forward<Converted>(container), message, user_ptr);
 
-          flatbuffers::FlatBufferBuilder builder;
-          builder.Finish(MessageType::Content::TableType::Pack(builder, &message));
+          BuilderPool::Lease builder;
+          builder->Finish(MessageType::Content::TableType::Pack(*builder, &message));
+
+          GenericSender<Converted>::topic.counters.countBytes(builder->GetSize());
 
           MessageInfo message_info = {
             .topic_info = GenericSender<Converted>::topic_info,
             .timestamp = message.getTimestamp(),
-            .serialized_message = builder.GetBufferSpan()
+            .serialized_message = builder->GetBufferSpan()
           };
 
-          Manager::PluginRegistration &plugin = *plugin_iterator;
+          const TopicMap::PluginCallback &plugin = plugin_list.front();
 
-          if (plugin.message_callback != nullptr) {
-            plugin.message_callback(plugin.user_ptr, message_info);
-          }
+          plugin.function(plugin.user_ptr, message_info);
         }
       }
     }
 
     /**
-     * @brief Flush all receivers of the relevant topic.
-     * This will unblock any waiting receivers calling the next() function and will invalidate the data stored in their buffers.
+     * @brief Send out multiple messages onto the topic at once.
+     * @details The receivers and plugins of the topic are only looked up once and each receiver is woken up only once for the whole batch.
+     * Receivers will observe the messages in order. All messages of a batch share a single timestamp, so that receivers with a minimum
+     * interval or a maximum rate accept at most the first message of each batch. Decimation is applied to every message.
      *
+     * @param containers Objects containing the data to be sent out.
      */
-    void flush() override
+    void putBatch(std::span<const Converted> containers) override
     {
-      TopicMap::Topic::ReceiverList receiver_list = GenericSender<Converted>::topic.getReceivers();
-
-      for (void *pointer : receiver_list) {
-        Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
-
-        receiver->flush_flag = true;
-        receiver->condition.notify_one();
+      if (containers.empty()) {
+        return;
       }
-    }
 
-    /**
-     * @brief Provide a message to the active plugins without actually send out any data over the topic.
-     *
-     * @param container Object caintaining the data to be sent out.
-     */
-    void trace(const Converted &container) override
-    {
       const Clock::time_point now = Clock::now();
+      const TraceContext trace_context = Tracer::publish(GenericSender<Converted>::topic_info.topic_hash, now, containers.size());
 
-      MessageType message;
-      MessageInfo message_info = {.topic_info = GenericSender<Converted>::topic_info};
+      GenericSender<Converted>::topic.counters.countMessages(containers.size());
 
-      flatbuffers::FlatBufferBuilder builder;
-      bool init_flag = false;
+      const TopicMap::Topic::Consumers consumers = GenericSender<Converted>::topic.getConsumers();
+      const std::vector<void *> &receiver_list = consumers.getReceivers();
+      const std::vector<void *> &const_receiver_list = consumers.getConstReceivers();
+      const std::vector<void *> &view_receiver_list = consumers.getViewReceivers();
+      const std::vector<TopicMap::PluginCallback> &plugin_list = consumers.getPlugins();
 
-      ConsumerGuard<u32> guard(
-        GenericSender<Converted>::node.environment.plugin_use_count, GenericSender<Converted>::node.environment.plugin_update_flag
-      );
+      // Storage shared among all callbacks and, depending on the fan out policy, all receivers.
+      std::vector<std::shared_ptr<Storage>> shared_storages(containers.size());
+      std::vector<bool> shared_storages_claimed(containers.size());
 
-      for (Manager::PluginRegistration &plugin : GenericSender<Converted>::node.environment.plugin_list) {
-        if (!plugin.filter.check(GenericSender<Converted>::topic_info.topic_hash)) {
-          continue;
+      const auto get_shared_storage =
+        [this, &containers, &shared_storages, now, &trace_context](std::size_t i) -> const std::shared_ptr<Storage> & {
+        if (!shared_storages[i]) {
+          shared_storages[i] = createStorage(containers[i], now, Tracer::getBatchContext(trace_context, i));
         }
 
-        if (!init_flag) {
-          Convert<MessageType::convertFrom>::call(container, message, user_ptr);
+        return shared_storages[i];
+      };
+
+      const std::size_t receiver_count = receiver_list.size() + const_receiver_list.size();
+      if (receiver_count != 0) {
+        Executor::Group group;
+        std::vector<std::future<void>> futures;
+        futures.reserve(receiver_count);
+
+        std::vector<std::size_t> indices;
+        indices.reserve(containers.size());
+
+        for (const std::vector<void *> *range : {&receiver_list, &const_receiver_list}) {
+          for (void *pointer : *range) {
+            Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
+
+            // Rate limits are checked before any conversion, so that skipped messages are free.
+            indices.clear();
+
+            for (std::size_t i = 0; i < containers.size(); ++i) {
+              if (receiver->accept(now)) {
+                indices.emplace_back(i);
+              }
+            }
+
+            if (indices.empty()) {
+              continue;
+            }
+
+            if (receiver->callback.valid()) {
+              std::vector<std::shared_ptr<Storage>> callback_storages;
+              callback_storages.reserve(indices.size());
+
+              for (std::size_t i : indices) {
+                callback_storages.emplace_back(get_shared_storage(i));
+              }
+
+              // A single task per receiver keeps the callbacks of a receiver in order.
+              auto function = [this, receiver, callback_storages = std::move(callback_storages)]() -> void {
+                for (const std::shared_ptr<Storage> &storage : callback_storages) {
+                  invokeCallback(receiver, *storage);
+                }
+              };
+
+              if (receiver->callback_executor != nullptr) {
+                receiver->callback_executor->submit(group, std::move(function));
+              } else {
+                futures.emplace_back(std::async(receiver->callback_policy, std::move(function)));
+              }
+            }
+
+            // Const receivers are only notified through their callbacks.
+            if (range != &receiver_list) {
+              continue;
+            }
 
-          builder.Finish(MessageType::Content::TableType::Pack(builder, &message));
+            std::vector<std::shared_ptr<Storage>> storages;
+            storages.reserve(indices.size());
 
-          message_info.timestamp = message.getTimestamp();
-          message_info.serialized_message = builder.GetBufferSpan();
+            // With the copy policy, only one receiver may be handed the shared storage. See put().
+            for (std::size_t i : indices) {
+              if (fan_out == FanOutPolicy::shared || !shared_storages_claimed[i]) {
+                storages.emplace_back(get_shared_storage(i));
+                shared_storages_claimed[i] = true;
+              } else {
+                storages.emplace_back(createStorage(containers[i], now, Tracer::getBatchContext(trace_context, i)));
+              }
+            }
 
-          init_flag = true;
+            receiver->store(storages, shared);
+          }
         }
 
-        if (plugin.message_callback != nullptr) {
-          plugin.message_callback(plugin.user_ptr, message_info);
+        for (std::future<void> &future : futures) {
+          future.get();
         }
+
+        group.wait();
       }
-    }
-  };
 
-  // Wrapper classes to allow flatbuffer types to also work as template arguments.
-  template <typename MessageType>
-  class Sender final : public SenderBase<MessageType>
-  {
-  public:
-    using Super = SenderBase<MessageType>;
-    using Ptr = std::unique_ptr<Sender<MessageType>>;
+      // Views are only created for messages accepted by at least one view receiver.
+      std::vector<std::shared_ptr<const View>> shared_views;
 
-    template <typename... Args>
-    explicit Sender(Args &&...args) :
-      Super(std::forward<Args>(args)...){};
-  };
+      if (view_receiver_list.size() != 0) {
+        shared_views.resize(containers.size());
 
-  template <typename FlatbufferType>
-  requires is_flatbuffer<FlatbufferType>
-  class Sender<FlatbufferType> final : public SenderBase<Message<FlatbufferType>>
-  {
-  public:
-    using Super = SenderBase<Message<FlatbufferType>>;
-    using Ptr = std::unique_ptr<Sender<FlatbufferType>>;
+        std::vector<std::shared_ptr<const View>> views;
+        views.reserve(containers.size());
 
-    template <typename... Args>
-    explicit Sender(Args &&...args) :
-      Super(std::forward<Args>(args)...){};
-  };
+        for (void *pointer : view_receiver_list) {
+          ViewReceiver<Flatbuffer> *receiver = reinterpret_cast<ViewReceiver<Flatbuffer> *>(pointer);
 
-  template <typename MessageType>
-  class Receiver;
+          views.clear();
 
-  template <typename MessageType>
-  requires is_message<MessageType>
-  class ReceiverBase;
+          for (std::size_t i = 0; i < containers.size(); ++i) {
+            if (!receiver->accept(now)) {
+              continue;
+            }
 
-  /**
-   * @brief @brief Generic receiver to declare virtual functions for type specific receiver instances to define.
-   * This allows access to receiver objetcs without knowledge of the underlying message types.
-   *
-   * @tparam ConvertedType Type of the objects provided by the receiver to be used by the user.
-   */
-  template <typename ConvertedType>
-  class GenericReceiver
-  {
-  public:
-    using Ptr = std::unique_ptr<GenericReceiver<ConvertedType>>;
+            if (!shared_views[i]) {
+              shared_views[i] = createView(*get_shared_storage(i));
+            }
 
-    virtual ~GenericReceiver() = default;
+            views.emplace_back(shared_views[i]);
+          }
 
-    /**
-     * @brief Get the lastest message sent over the topic.
-     * This call is guaranteed to not block.
-     *
-     * @return ConvertedType The latest message sent over the topic.
-     * @throw TopicNoDataAvailableException When the topic has no valid data available.
-     */
-    virtual ConvertedType latest() = 0;
+          if (!views.empty()) {
+            receiver->store(views, shared);
+          }
+        }
+      }
 
-    /**
-     * @brief Get the next message sent over the topic.
-     * @details This call might block. However, it is guaranteed that successive calls will yield different messages.
-     * Subsequent calls to latest() are unsafe.
-     *
-     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
-     * @return ConvertedType The next message sent over the topic.
-     * @throw TopicNoDataAvailableException When the topic has no valid data available.
-     * @throw TopicTimeoutException When the timeout is exceeded.
-     */
-    virtual ConvertedType next(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()) = 0;
+      if (plugin_list.size() == 0) {
+        return;
+      }
 
-    template <typename R, typename P>
-    ConvertedType next(const std::chrono::duration<R, P> &timeout_duration = std::chrono::nanoseconds::zero())
-    {
-      return next(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
+      for (std::size_t i = 0; i < containers.size(); ++i) {
+        if (!shared_views.empty() && shared_views[i]) {
+          traceView(*shared_views[i], plugin_list);
+        } else {
+          traceStorage(*get_shared_storage(i), plugin_list);
+        }
+      }
     }
 
     /**
-     * @brief Get the internal buffer size.
+     * @brief Flush all receivers of the relevant topic.
+     * This will unblock any waiting receivers calling the next() function and will invalidate the data stored in their buffers.
      *
-     * @return std::size_t
      */
-    [[nodiscard]] inline std::size_t getBufferSize() const
+    void flush() override
     {
-      return index_mask + 1;
+      const TopicMap::Topic::Consumers consumers = GenericSender<Converted>::topic.getConsumers();
+
+      for (void *pointer : consumers.getReceivers()) {
+        Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
+
+        receiver->invalidate();
+      }
+
+      for (void *pointer : consumers.getViewReceivers()) {
+        ViewReceiver<Flatbuffer> *receiver = reinterpret_cast<ViewReceiver<Flatbuffer> *>(pointer);
+
+        receiver->invalidate();
+      }
     }
 
     /**
-     * @brief Get information about the relevant topic.
+     * @brief Provide a message to the active plugins without actually send out any data over the topic.
      *
-     * @return const TopicInfo& Information about the topic.
+     * @param container Object caintaining the data to be sent out.
+     */
+    void trace(const Converted &container) override
+    {
+      const TopicMap::Topic::Consumers consumers = GenericSender<Converted>::topic.getConsumers();
+
+      traceContainer(container, consumers.getPlugins());
+    }
+
+  private:
+    /**
+     * @brief Send out a message onto the topic to the consumers of a snapshot.
+     *
+     * @param container Object containing the data to be sent out.
+     * @param consumers Snapshot of the consumers of the topic.
+     */
+    void putInternal(const Converted &container, const TopicMap::Topic::Consumers &consumers)
+    {
+      const Clock::time_point now = Clock::now();
+      const TraceContext trace_context = Tracer::publish(GenericSender<Converted>::topic_info.topic_hash, now);
+
+      GenericSender<Converted>::topic.counters.countMessages(1);
+
+      const std::vector<void *> &receiver_list = consumers.getReceivers();
+      const std::vector<void *> &const_receiver_list = consumers.getConstReceivers();
+
+      // Storage shared among all callbacks and, depending on the fan out policy, all receivers.
+      std::shared_ptr<Storage> shared_storage;
+      bool shared_storage_claimed = false;
+
+      const std::size_t receiver_count = receiver_list.size() + const_receiver_list.size();
+      if (receiver_count != 0) {
+        Executor::Group group;
+        std::vector<std::future<void>> futures;
+        futures.reserve(receiver_count);
+
+        for (const std::vector<void *> *range : {&receiver_list, &const_receiver_list}) {
+          for (void *pointer : *range) {
+            Receiver<MessageType> *receiver = reinterpret_cast<Receiver<MessageType> *>(pointer);
+
+            // Rate limits are checked before any conversion, so that skipped messages are free.
+            if (!receiver->accept(now)) {
+              continue;
+            }
+
+            if (receiver->callback.valid()) {
+              if (!shared_storage) {
+                shared_storage = createStorage(container, now, trace_context);
+              }
+
+              auto function = [this, receiver, &storage = *shared_storage]() -> void {
+                invokeCallback(receiver, storage);
+              };
+
+              if (receiver->callback_executor != nullptr) {
+                receiver->callback_executor->submit(group, std::move(function));
+              } else {
+                futures.emplace_back(std::async(receiver->callback_policy, std::move(function)));
+              }
+            }
+
+            // Const receivers are only notified through their callbacks.
+            if (range != &receiver_list) {
+              continue;
+            }
+
+            std::shared_ptr<Storage> storage;
+
+            // With the copy policy, every receiver must be able to move its message out of its buffer, which requires a storage of its own.
+            // Only the storage shared with callbacks, views and plugins can be handed to one of them. As long as this function holds it,
+            // the receiver will not move out of it.
+            if (fan_out == FanOutPolicy::shared || !shared_storage_claimed) {
+              if (!shared_storage) {
+                shared_storage = createStorage(container, now, trace_context);
+              }
+
+              storage = shared_storage;
+              shared_storage_claimed = true;
+            } else {
+              storage = createStorage(container, now, trace_context);
+            }
+
+            receiver->store(std::move(storage), shared);
+          }
+        }
+
+        for (std::future<void> &future : futures) {
+          future.get();
+        }
+
+        group.wait();
+      }
+
+      const std::vector<void *> &view_receiver_list = consumers.getViewReceivers();
+
+      // The message is serialized only once for all view receivers and plugins.
+      std::shared_ptr<const View> shared_view;
+
+      for (void *pointer : view_receiver_list) {
+        ViewReceiver<Flatbuffer> *receiver = reinterpret_cast<ViewReceiver<Flatbuffer> *>(pointer);
+
+        if (!receiver->accept(now)) {
+          continue;
+        }
+
+        if (!shared_view) {
+          if (!shared_storage) {
+            shared_storage = createStorage(container, now, trace_context);
+          }
+
+          shared_view = createView(*shared_storage);
+        }
+
+        receiver->store(std::span<const std::shared_ptr<const View>>(&shared_view, 1), shared);
+      }
+
+      const std::vector<TopicMap::PluginCallback> &plugin_list = consumers.getPlugins();
+
+      if (shared_view) {
+        traceView(*shared_view, plugin_list);
+      } else if (shared_storage) {
+        traceStorage(*shared_storage, plugin_list);
+      } else {
+        traceContainer(container, plugin_list);
+      }
+    }
+
+
+    /**
+     * @brief Provide a message to the plugins of a snapshot.
+     *
+     * @param container Object containing the data to be sent out.
+     * @param plugins Plugins interested in the topic.
+     */
+    void traceContainer(const Converted &container, const std::vector<TopicMap::PluginCallback> &plugins)
+    {
+      MessageType message;
+
+      traceInternal(plugins, [this, &container, &message](flatbuffers::FlatBufferBuilder &builder, MessageInfo &message_info) -> void {
+        Convert<MessageType::convertFrom>::call(container, message, user_ptr);
+        builder.Finish(MessageType::Content::TableType::Pack(builder, &message));
+
+        GenericSender<Converted>::topic.counters.countBytes(builder.GetSize());
+
+        message_info.timestamp = message.getTimestamp();
+        message_info.serialized_message = builder.GetBufferSpan();
+      });
+    }
+
+    /**
+     * @brief Provide an already converted message to the active plugins.
+     *
+     * @param storage Converted message to be provided.
+     * @param plugins Plugins interested in the topic.
+     */
+    void traceStorage(const Storage &storage, const std::vector<TopicMap::PluginCallback> &plugins)
+    {
+      traceInternal(plugins, [this, &storage](flatbuffers::FlatBufferBuilder &builder, MessageInfo &message_info) -> void {
+        builder.Finish(MessageType::Content::TableType::Pack(builder, &storage));
+
+        GenericSender<Converted>::topic.counters.countBytes(builder.GetSize());
+
+        message_info.timestamp = storage.getTimestamp();
+        message_info.serialized_message = builder.GetBufferSpan();
+      });
+    }
+
+    /**
+     * @brief Provide an already serialized message to the active plugins.
+     *
+     * @param view Serialized message to be provided.
+     * @param plugins Plugins interested in the topic.
+     */
+    void traceView(const View &view, const std::vector<TopicMap::PluginCallback> &plugins)
+    {
+      traceInternal(plugins, [&view](flatbuffers::FlatBufferBuilder &, MessageInfo &message_info) -> void {
+        const std::span<const u8> buffer = view.getBuffer();
+
+        // Plugins only ever read the serialized message.
+        message_info.timestamp = view.getTimestamp();
+        message_info.serialized_message = flatbuffers::span<u8>(const_cast<u8 *>(buffer.data()), buffer.size());
+      });
+    }
+
+    /**
+     * @brief Provide a serialized message to the active plugins.
+     * The message will only be serialized if at least one plugin is interested in the topic. Builders are drawn from a thread local pool, so
+     * that their buffers are reused across messages.
+     *
+     * @tparam Serializer Type of the callable object to serialize the message into the message info.
+     * @param plugins Plugins interested in the topic.
+     * @param serializer Callable object to serialize the message into the message info using the supplied builder.
+     */
+    template <typename Serializer>
+    void traceInternal(const std::vector<TopicMap::PluginCallback> &plugins, Serializer &&serializer)
+    {
+      MessageInfo message_info = {.topic_info = GenericSender<Converted>::topic_info};
+
+      std::optional<BuilderPool::Lease> builder;
+
+      // The plugins interested in the topic are determined whenever a plugin is added or removed.
+      for (const TopicMap::PluginCallback &plugin : plugins) {
+        if (!builder) {
+          builder.emplace();
+          serializer(**builder, message_info);
+        }
+
+        plugin.function(plugin.user_ptr, message_info);
+      }
+    }
+  };
+
+  // Wrapper classes to allow flatbuffer types to also work as template arguments.
+  template <typename MessageType>
+  class Sender final : public SenderBase<MessageType>
+  {
+  public:
+    using Super = SenderBase<MessageType>;
+    using Ptr = std::unique_ptr<Sender<MessageType>>;
+
+    template <typename... Args>
+    explicit Sender(Args &&...args) :
+      Super(std::forward<Args>(args)...){};
+  };
+
+  template <typename FlatbufferType>
+  requires is_flatbuffer<FlatbufferType>
+  class Sender<FlatbufferType> final : public SenderBase<Message<FlatbufferType>>
+  {
+  public:
+    using Super = SenderBase<Message<FlatbufferType>>;
+    using Ptr = std::unique_ptr<Sender<FlatbufferType>>;
+
+    template <typename... Args>
+    explicit Sender(Args &&...args) :
+      Super(std::forward<Args>(args)...){};
+  };
+
+  template <typename MessageType>
+  class Receiver;
+
+  template <typename MessageType>
+  requires is_message<MessageType>
+  class ReceiverBase;
+
+  template <typename... MessageTypes>
+  class Synchronizer;
+
+  /**
+   * @brief Internal message buffer of a receiver.
+   * @details Each slot holds a pointer to a message along with its sequence number. The sequence number equals the receive count of the
+   * stored message. It is invalidated while the slot is being written to, so that readers are able to detect concurrent updates instead of
+   * locking the slot. Readers and the sender never wait for each other for longer than a single pointer access. The pointer itself is a
+   * std::atomic<std::shared_ptr>, which is not lock-free in common standard libraries. Its accesses are serialized by short internal locks.
+   *
+   * @tparam T Type of the stored messages.
+   */
+  template <typename T>
+  class MessageBuffer
+  {
+  public:
+    struct MessageData
+    {
+      static constexpr std::size_t invalid_sequence = std::numeric_limits<std::size_t>::max();
+
+      std::atomic<std::shared_ptr<T>> message;
+      std::atomic<std::size_t> sequence = invalid_sequence;
+    };
+
+    /**
+     * @brief Construct a new Message Buffer object given its size.
+     *
+     * @param size Size of the message buffer. It must be a power of 2.
+     */
+    explicit MessageBuffer(std::size_t size) :
+      size(size)
+    {
+      buffer = allocator.allocate(size);
+
+      for (std::size_t i = 0; i < size; ++i) {
+        std::construct_at<MessageData>(buffer + i);
+      }
+    }
+
+    /**
+     * @brief Destroy the Message Buffer object.
+     *
+     */
+    ~MessageBuffer()
+    {
+      for (std::size_t i = 0; i < size; ++i) {
+        std::destroy_at<MessageData>(buffer + i);
+      }
+
+      allocator.deallocate(buffer, size);
+    }
+
+    /**
+     * @brief Store a message in the slot corresponding to the supplied receive count.
+     * Only a single thread may store messages at the same time.
+     *
+     * @param local_count Receive count of the message.
+     * @param message Message to be stored.
+     */
+    void store(std::size_t local_count, std::shared_ptr<T> &&message)
+    {
+      MessageData &slot = buffer[local_count & (size - 1)];
+
+      slot.sequence.store(MessageData::invalid_sequence, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.message.store(std::move(message), std::memory_order_relaxed);
+      slot.sequence.store(local_count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Load the message with the supplied receive count.
+     *
+     * @param local_count Receive count of the requested message.
+     * @param message Pointer to the requested message. It is empty when the message has already been released.
+     * @return true On success.
+     * @return false When the slot has been overwritten concurrently.
+     */
+    bool load(std::size_t local_count, std::shared_ptr<T> &message)
+    {
+      MessageData &slot = buffer[local_count & (size - 1)];
+
+      const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      message = slot.message.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      return sequence == local_count && sequence == slot.sequence.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Remove a message from its slot, unless the slot has already been overwritten.
+     *
+     * @param local_count Receive count of the message.
+     * @param message Pointer to the message to be removed.
+     */
+    void release(std::size_t local_count, const std::shared_ptr<T> &message)
+    {
+      std::shared_ptr<T> expected = message;
+      buffer[local_count & (size - 1)].message.compare_exchange_strong(expected, nullptr);
+    }
+
+  private:
+    MessageData *buffer;
+    std::allocator<MessageData> allocator;
+
+    const std::size_t size;
+  };
+
+  /**
+   * @brief @brief Generic receiver to declare virtual functions for type specific receiver instances to define.
+   * This allows access to receiver objetcs without knowledge of the underlying message types.
+   *
+   * @tparam ConvertedType Type of the objects provided by the receiver to be used by the user.
+   */
+  template <typename ConvertedType>
+  class GenericReceiver : public Waitable
+  {
+  public:
+    using Ptr = std::unique_ptr<GenericReceiver<ConvertedType>>;
+
+    virtual ~GenericReceiver()
+    {
+      leaveWaitSet();
+    }
+
+    /**
+     * @brief Get the lastest message sent over the topic.
+     * This call is guaranteed to not block.
+     *
+     * @return ConvertedType The latest message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     */
+    virtual ConvertedType latest() = 0;
+
+    /**
+     * @brief Get the next message sent over the topic.
+     * @details This call might block. However, it is guaranteed that successive calls will yield different messages.
+     * Subsequent calls to latest() are unsafe.
+     *
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return ConvertedType The next message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
+     */
+    virtual ConvertedType next(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()) = 0;
+
+    template <typename R, typename P>
+    ConvertedType next(const std::chrono::duration<R, P> &timeout_duration = std::chrono::nanoseconds::zero())
+    {
+      return next(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
+    }
+
+    /**
+     * @brief Get all unread messages sent over the topic, oldest first.
+     * This call blocks until at least one unread message is available. The messages are moved out of the internal buffer where
+     * possible. Subsequent calls to latest() are unsafe.
+     *
+     * @param max_count Maximum number of messages to be returned. It must be at least 1.
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return std::vector<ConvertedType> Unread messages sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
+     */
+    virtual std::vector<ConvertedType> nextBatch(
+      std::size_t max_count, const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()
+    ) = 0;
+
+    template <typename R, typename P>
+    std::vector<ConvertedType> nextBatch(std::size_t max_count, const std::chrono::duration<R, P> &timeout_duration)
+    {
+      return nextBatch(max_count, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
+    }
+
+    /**
+     * @brief Awaitable to suspend a coroutine until the next message sent over the topic is available.
+     *
+     */
+    class NextAwaiter : private Waitable::Waiter
+    {
+    public:
+      explicit NextAwaiter(GenericReceiver<ConvertedType> &receiver) :
+        Waiter{.function = &NextAwaiter::wake},
+        receiver(receiver)
+      {}
+
+      NextAwaiter(const NextAwaiter &) = delete;
+
+      ~NextAwaiter()
+      {
+        if (registered) {
+          receiver.removeWaiter(*this);
+        }
+      }
+
+      [[nodiscard]] bool await_ready() const
+      {
+        return isReady(receiver);
+      }
+
+      bool await_suspend(std::coroutine_handle<> new_handle)
+      {
+        scheduler = Scheduler::current();
+
+        if (scheduler == nullptr) {
+          throw BadUsageException("Receivers can only be awaited from within a scheduler.", receiver.node.getLogger());
+        }
+
+        handle = new_handle;
+        registered = true;
+
+        // The awaiter might be resumed and destroyed by another thread as soon as it has been registered.
+        GenericReceiver<ConvertedType> &local_receiver = receiver;
+        local_receiver.addWaiter(*this);
+
+        if (!isReady(local_receiver)) {
+          return true;
+        }
+
+        // A message has been received before the waiter was registered.
+        if (local_receiver.removeWaiter(*this)) {
+          registered = false;
+          return false;
+        }
+
+        return true;
+      }
+
+      ConvertedType await_resume()
+      {
+        registered = false;
+
+        return receiver.next();
+      }
+
+    private:
+      static bool isReady(const GenericReceiver<ConvertedType> &receiver)
+      {
+        return receiver.flush_flag.load() || hasUpdate(receiver);
+      }
+
+      static void wake(Waiter &waiter)
+      {
+        NextAwaiter &self = static_cast<NextAwaiter &>(waiter);
+
+        self.scheduler->schedule(self.handle);
+      }
+
+      GenericReceiver<ConvertedType> &receiver;
+      Scheduler *scheduler = nullptr;
+      std::coroutine_handle<> handle;
+      bool registered = false;
+    };
+
+    /**
+     * @brief Get the next message sent over the topic from within a coroutine.
+     * The coroutine is suspended without blocking its thread until a message is available. Only one coroutine may await a receiver at a
+     * time. Subsequent calls to latest() are unsafe.
+     *
+     * @return NextAwaiter Awaitable yielding the next message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw BadUsageException When the calling coroutine is not run by a Scheduler.
+     */
+    NextAwaiter nextAsync()
+    {
+      return NextAwaiter(*this);
+    }
+
+    /**
+     * @brief Get the internal buffer size.
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] inline std::size_t getBufferSize() const
+    {
+      return index_mask + 1;
+    }
+
+    /**
+     * @brief Get information about the relevant topic.
+     *
+     * @return const TopicInfo& Information about the topic.
      */
     [[nodiscard]] inline const TopicInfo &getTopicInfo() const
     {
-      return topic_info;
+      return topic_info;
+    }
+
+    /**
+     * @brief Get the queue policy of the receiver.
+     *
+     * @return QueuePolicy Queue policy.
+     */
+    [[nodiscard]] inline QueuePolicy getQueuePolicy() const
+    {
+      return queue_policy;
+    }
+
+    /**
+     * @brief Check whether unread messages are available without claiming them.
+     * This call is guaranteed to not block.
+     *
+     * @return true When unread messages are available and the topic has not been flushed.
+     */
+    [[nodiscard]] inline bool hasUnread() const
+    {
+      return !flush_flag.load() && count.load() != read_count.load();
+    }
+
+    /**
+     * @brief Get the number of messages that have been dropped because the buffer was full.
+     *
+     * @return u64 Number of dropped messages.
+     */
+    [[nodiscard]] inline u64 getDroppedCount() const
+    {
+      return dropped_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of messages that have been replaced by newer messages before being read.
+     *
+     * @return u64 Number of overwritten messages.
+     */
+    [[nodiscard]] inline u64 getOverwrittenCount() const
+    {
+      return overwritten_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Limit the rate at which the receiver accepts messages.
+     * @details Senders check the limits before converting a message, so that skipped messages do not cause any conversion work. The
+     * messages of a batch sent via putBatch() share a single timestamp. Interval and rate limits therefore accept at most one message per
+     * batch, whereas decimation counts every message of the batch.
+     *
+     * @param rate_limit Limits to be applied to the receiver.
+     * @throw InvalidArgumentException When the maximum rate or the minimum interval is negative.
+     */
+    void setRateLimit(const RateLimit &rate_limit)
+    {
+      if (rate_limit.max_rate < 0.0 || rate_limit.min_interval < std::chrono::nanoseconds::zero()) {
+        throw InvalidArgumentException("Rate limits must not be negative.", node.getLogger());
+      }
+
+      std::chrono::nanoseconds interval = rate_limit.min_interval;
+
+      if (rate_limit.max_rate != 0.0) {
+        const std::chrono::duration<double> rate_interval(1.0 / rate_limit.max_rate);
+
+        interval = std::max(interval, std::chrono::duration_cast<std::chrono::nanoseconds>(rate_interval));
+      }
+
+      decimation.store(std::max<std::size_t>(rate_limit.decimation, 1), std::memory_order_relaxed);
+      min_interval.store(interval.count(), std::memory_order_relaxed);
+    }
+
+  protected:
+    GenericReceiver(
+      TopicInfo topic_info,
+      TopicMap::Topic &topic,
+      Node &node,
+      std::size_t buffer_size,
+      QueuePolicy queue_policy,
+      const std::chrono::nanoseconds &block_timeout
+    ) :
+      Waitable(&GenericReceiver::hasUpdate),
+      topic_info(std::move(topic_info)),
+      topic(topic),
+      node(node),
+      index_mask(calculateBufferMask(buffer_size)),
+      queue_policy(queue_policy),
+      block_timeout(block_timeout),
+      count(index_mask),
+      read_count(index_mask),
+      flush_flag(true),
+      waiter_count(0),
+      store_ticket(0),
+      store_turn(0),
+      dropped_count(0),
+      overwritten_count(0),
+      decimation(1),
+      decimation_count(0),
+      min_interval(0),
+      next_time(std::numeric_limits<i64>::min())
+    {}
+
+    friend class TopicMap;
+
+    /**
+     * @brief Listener to be notified each time the receiver is signalled.
+     * In contrast to NextAwaiter, the listener registers itself again each time it is notified. The notification function is called by the
+     * signalling sender. As it shares the registration slot of NextAwaiter, the receiver cannot be awaited while the listener exists.
+     *
+     */
+    class UpdateListener : private Waitable::Waiter
+    {
+    public:
+      using Function = void (*)(void *user_ptr);
+
+      UpdateListener(GenericReceiver<ConvertedType> &receiver, Function function, void *user_ptr) :
+        Waiter{.function = &UpdateListener::wake},
+        receiver(receiver),
+        function(function),
+        user_ptr(user_ptr),
+        stopping(false)
+      {
+        receiver.addWaiter(*this);
+      }
+
+      UpdateListener(const UpdateListener &) = delete;
+
+      ~UpdateListener()
+      {
+        stopping.store(true);
+
+        // A concurrent notification might register the listener again before it observes the stop.
+        if (!receiver.removeWaiter(*this)) {
+          receiver.removeWaiter(*this);
+        }
+
+        // Wait for a concurrent notification to finish.
+        receiver.synchronizeSignals();
+      }
+
+    private:
+      static void wake(Waiter &waiter)
+      {
+        UpdateListener &self = static_cast<UpdateListener &>(waiter);
+
+        if (self.stopping.load()) {
+          return;
+        }
+
+        self.receiver.addWaiter(self);
+        self.function(self.user_ptr);
+      }
+
+      GenericReceiver<ConvertedType> &receiver;
+      const Function function;
+      void *const user_ptr;
+      std::atomic<bool> stopping;
+    };
+
+    /**
+     * @brief Check whether the receiver accepts a message according to its rate limits.
+     * This must be called exactly once per message and receiver. Only the senders of the relevant topic may call this function.
+     *
+     * @param now Timestamp of the message.
+     * @return true When the message is to be delivered to the receiver.
+     */
+    bool accept(Clock::time_point now)
+    {
+      const std::size_t local_decimation = decimation.load(std::memory_order_relaxed);
+
+      if (local_decimation > 1 && decimation_count.fetch_add(1, std::memory_order_relaxed) % local_decimation != 0) {
+        return false;
+      }
+
+      const i64 interval = min_interval.load(std::memory_order_relaxed);
+
+      if (interval == 0) {
+        return true;
+      }
+
+      const i64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+      i64 local_next_time = next_time.load(std::memory_order_relaxed);
+
+      do {
+        if (time < local_next_time) {
+          return false;
+        }
+      } while (!next_time.compare_exchange_weak(local_next_time, time + interval, std::memory_order_relaxed));
+
+      return true;
+    }
+
+    /**
+     * @brief Wake up all threads waiting for new data.
+     * The mutex is only acquired when there is at least one waiting thread.
+     *
+     */
+    void notify()
+    {
+      if (waiter_count.load() != 0) {
+        std::lock_guard guard(condition_mutex);
+        condition.notify_all();
+      }
+    }
+
+    /**
+     * @brief Wake up all threads waiting for new data as well as the wait set the receiver is attached to.
+     * Only the senders of the relevant topic may call this function.
+     *
+     */
+    void publish()
+    {
+      notify();
+      Waitable::signal();
+    }
+
+    /**
+     * @brief Mark the data stored in the buffer as invalid and wake up all waiting threads.
+     *
+     */
+    void invalidate()
+    {
+      flush_flag.store(true);
+      notify();
+      Waitable::signal(true);
+    }
+
+    /**
+     * @brief RAII guard to serialize store operations of multiple senders on a receiver.
+     * Senders are served in the order in which they have drawn their ticket. Waiting senders block instead of spinning, as a turn may be
+     * held for the duration of a blocking store or a whole batch. When disabled, the guard is a no-op.
+     *
+     */
+    class StoreGuard
+    {
+    public:
+      StoreGuard(GenericReceiver<ConvertedType> &receiver, bool enabled) :
+        receiver(enabled ? &receiver : nullptr)
+      {
+        if (!enabled) {
+          return;
+        }
+
+        ticket = receiver.store_ticket.fetch_add(1, std::memory_order_relaxed);
+
+        std::size_t turn = receiver.store_turn.load(std::memory_order_acquire);
+
+        while (turn != ticket) {
+          receiver.store_turn.wait(turn, std::memory_order_acquire);
+          turn = receiver.store_turn.load(std::memory_order_acquire);
+        }
+      }
+
+      StoreGuard(const StoreGuard &) = delete;
+
+      ~StoreGuard()
+      {
+        if (receiver != nullptr) {
+          receiver->store_turn.store(ticket + 1, std::memory_order_release);
+
+          // All waiting senders are woken up, as only the one holding the next ticket may proceed.
+          receiver->store_turn.notify_all();
+        }
+      }
+
+    private:
+      GenericReceiver<ConvertedType> *const receiver;
+      std::size_t ticket;
+    };
+
+    /**
+     * @brief Make a message that has been stored in the buffer visible to readers.
+     * Waiting readers are not woken up, so that a batch of messages only requires a single call to notify().
+     *
+     * @param local_count Receive count of the message.
+     */
+    void commit(std::size_t local_count)
+    {
+      flush_flag.store(false);
+      count.store(local_count);
+    }
+
+    /**
+     * @brief Check whether the buffer contains only unread messages.
+     *
+     * @return true When the buffer is full.
+     */
+    bool isFull() const
+    {
+      return count.load() - read_count.load() > index_mask;
+    }
+
+    /**
+     * @brief Make room in the buffer for another message according to the queue policy.
+     * Only the sender of the relevant topic may call this function.
+     *
+     * @return true When the message can be stored.
+     * @return false When the message is to be dropped.
+     */
+    bool reserve()
+    {
+      // Stale data of a flushed receiver will never be read.
+      if (flush_flag.load()) {
+        read_count.store(count.load(std::memory_order_relaxed));
+        return true;
+      }
+
+      if (queue_policy == QueuePolicy::overwrite_oldest || !isFull()) {
+        return true;
+      }
+
+      if (queue_policy == QueuePolicy::drop_newest) {
+        return false;
+      }
+
+      // Messages of the current batch might not have been announced to the readers yet.
+      publish();
+
+      std::unique_lock lock(condition_mutex);
+      waiter_count.fetch_add(1);
+
+      const auto predicate = [this]() -> bool {
+        return !isFull() || flush_flag.load();
+      };
+
+      bool result = true;
+
+      if (block_timeout == std::chrono::nanoseconds::zero()) {
+        condition.wait(lock, predicate);
+      } else {
+        result = condition.wait_for(lock, block_timeout, predicate);
+      }
+
+      waiter_count.fetch_sub(1);
+
+      if (result && flush_flag.load()) {
+        read_count.store(count.load(std::memory_order_relaxed));
+      }
+
+      return result;
+    }
+
+    /**
+     * @brief Mark all messages up to the supplied receive count as read.
+     * Unread messages that have been skipped are accounted for as overwritten.
+     *
+     * @param local_count Receive count of the message that has been read.
+     */
+    void markRead(std::size_t local_count)
+    {
+      std::size_t previous_count = read_count.load(std::memory_order_relaxed);
+
+      while (previous_count < local_count && !read_count.compare_exchange_weak(previous_count, local_count)) {}
+
+      if (previous_count < local_count) {
+        topic.counters.recordLag(local_count - previous_count);
+      }
+
+      if (previous_count + 1 < local_count) {
+        countOverwritten(local_count - previous_count - 1);
+      }
+    }
+
+    /**
+     * @brief Account for a message that has been dropped because the buffer was full.
+     *
+     */
+    void countDropped()
+    {
+      dropped_count.fetch_add(1, std::memory_order_relaxed);
+      topic.counters.countDropped();
+    }
+
+    /**
+     * @brief Account for messages that have been replaced by newer messages before being read.
+     *
+     * @param overwritten Number of overwritten messages.
+     */
+    void countOverwritten(u64 overwritten)
+    {
+      overwritten_count.fetch_add(overwritten, std::memory_order_relaxed);
+      topic.counters.countOverwritten(overwritten);
+    }
+
+    /**
+     * @brief Load all unread messages that are still stored in the buffer and mark them as read.
+     * Unread messages that have already been overwritten are accounted for as such.
+     *
+     * @tparam T Type of the stored messages.
+     * @param buffer Internal message buffer of the receiver.
+     * @param messages Vector to which the messages will be appended.
+     * @param max_count Maximum number of messages to be loaded.
+     * @return std::size_t Receive count of the first loaded message.
+     */
+    template <typename T>
+    std::size_t claimUnread(MessageBuffer<T> &buffer, std::vector<std::shared_ptr<T>> &messages, std::size_t max_count)
+    {
+      const std::size_t offset = messages.size();
+
+      while (true) {
+        messages.resize(offset);
+
+        std::size_t local_read_count = read_count.load();
+        const std::size_t local_count = count.load(std::memory_order_acquire);
+
+        if (local_count == local_read_count || max_count == 0) {
+          return local_count;
+        }
+
+        // Only the most recent messages are still stored in the buffer.
+        std::size_t first_count = local_read_count + 1;
+        if (local_count - first_count > index_mask) {
+          first_count = local_count - index_mask;
+        }
+
+        const std::size_t last_count = first_count + std::min(max_count, local_count - first_count + 1) - 1;
+
+        bool valid = true;
+
+        for (std::size_t i = first_count; i <= last_count; ++i) {
+          std::shared_ptr<T> message;
+
+          if (!buffer.load(i, message) || !message) {
+            valid = false;
+            break;
+          }
+
+          messages.emplace_back(std::move(message));
+        }
+
+        // Retry when the messages have been overwritten or claimed by another reader in the meantime.
+        if (!valid || !read_count.compare_exchange_strong(local_read_count, last_count)) {
+          continue;
+        }
+
+        topic.counters.recordLag(local_count - local_read_count);
+
+        if (first_count > local_read_count + 1) {
+          countOverwritten(first_count - local_read_count - 1);
+        }
+
+        // Wake up a sender waiting for room in the buffer.
+        if (queue_policy != QueuePolicy::overwrite_oldest) {
+          notify();
+        }
+
+        return first_count;
+      }
+    }
+
+    /**
+     * @brief Block until the receive count differs from the supplied value or the receiver is flushed.
+     *
+     * @param local_count Receive count of the last message read.
+     * @param timeout_duration Duration of the timeout. A duration of zero will wait indefinitely.
+     * @param timeout_point Absolute point in time of the timeout.
+     * @return true When new data is available or the receiver has been flushed.
+     * @return false When the timeout has been exceeded.
+     */
+    bool waitForUpdate(
+      std::size_t local_count,
+      const std::chrono::nanoseconds &timeout_duration,
+      const std::chrono::steady_clock::time_point &timeout_point
+    )
+    {
+      std::unique_lock lock(condition_mutex);
+      waiter_count.fetch_add(1);
+
+      const auto predicate = [this, local_count]() -> bool {
+        return count.load() != local_count || flush_flag.load();
+      };
+
+      bool result = true;
+
+      if (timeout_duration == std::chrono::nanoseconds::zero()) {
+        condition.wait(lock, predicate);
+      } else {
+        result = condition.wait_until(lock, timeout_point, predicate);
+      }
+
+      waiter_count.fetch_sub(1);
+
+      return result;
+    }
+
+    /**
+     * @brief Check whether a receiver has unread data available.
+     *
+     * @param object Receiver to be checked.
+     * @return true When unread data is available.
+     */
+    static bool hasUpdate(const Waitable &object)
+    {
+      const GenericReceiver<ConvertedType> &receiver = static_cast<const GenericReceiver<ConvertedType> &>(object);
+
+      return receiver.count.load() != receiver.read_count.load();
+    }
+
+    /**
+     * @brief Calculate the internal buffer size required to satisfy the provided buffer size.
+     * This will either be the provided buffer size itself or the next power of 2.
+     *
+     * @param buffer_size Provided buffer size of the receiver.
+     * @return std::size_t Internal buffer size.
+     */
+    std::size_t calculateBufferSize(std::size_t buffer_size)
+    {
+      if (buffer_size < 4) {
+        throw InvalidArgumentException("The buffer size for a Receiver must be at least 4.", node.getLogger());
+      }
+
+      std::size_t mask = std::size_t(1) << ((sizeof(std::size_t) * 8) - 1);
+
+      while (true) {
+        if (mask & buffer_size) {
+          if (mask ^ buffer_size) {
+            return mask << 1;
+          } else {
+            return mask;
+          }
+        }
+
+        mask >>= 1;
+      }
+    }
+
+    /**
+     * @brief Calculate the buffer mask used internally to compute a buffer index from a receive count.
+     *
+     * @param buffer_size Provided buffer size of the receiver.
+     * @return std::size_t Internal buffer mask.
+     */
+    std::size_t calculateBufferMask(std::size_t buffer_size)
+    {
+      return calculateBufferSize(buffer_size) - 1;
+    }
+
+    const TopicInfo topic_info;
+    TopicMap::Topic &topic;
+
+    Node &node;
+
+    const std::size_t index_mask;
+
+    const QueuePolicy queue_policy;
+    const std::chrono::nanoseconds block_timeout;
+
+    std::atomic<std::size_t> count;
+    std::atomic<std::size_t> read_count;
+    std::atomic<bool> flush_flag;
+
+    std::atomic<std::size_t> waiter_count;
+    std::mutex condition_mutex;
+    std::condition_variable condition;
+
+    std::atomic<std::size_t> store_ticket;
+    std::atomic<std::size_t> store_turn;
+
+    std::atomic<u64> dropped_count;
+    std::atomic<u64> overwritten_count;
+
+    std::atomic<std::size_t> decimation;
+    std::atomic<std::size_t> decimation_count;
+    std::atomic<i64> min_interval;
+    std::atomic<i64> next_time;
+  };
+
+  /**
+   * @brief Generic class to receive messages from a topic.
+   *
+   * @tparam MessageType Type of the messages sent over the topic.
+   */
+  template <typename MessageType>
+  requires is_message<MessageType>
+  class ReceiverBase : public GenericReceiver<typename MessageType::Converted>
+  {
+  public:
+    using Storage = typename MessageType::Storage;
+    using Converted = typename MessageType::Converted;
+
+    template <auto *Function>
+    using Convert = ConversionFunction<Function>;
+    template <auto *Function>
+    using Move = MoveFunction<Function>;
+
+  private:
+    /**
+     * @brief Construct a new Receiver object.
+     *
+     * @param topic_name Name of the topic.
+     * @param node Reference to the parent node.
+     * @param user_ptr User pointer to be used by the conversion function.
+     * @param buffer_size Size of the internal receiver buffer. It must be at least 4 and should ideally be a power of 2.
+     * @param queue_policy Policy to handle new messages when the consumer falls behind.
+     * @param block_timeout Maximum duration a sender will be blocked when using QueuePolicy::block_sender. A duration of zero will block
+     * indefinitely.
+     */
+    ReceiverBase(
+      const std::string &topic_name,
+      Node &node,
+      void *user_ptr = nullptr,
+      std::size_t buffer_size = 4,
+      QueuePolicy queue_policy = QueuePolicy::overwrite_oldest,
+      const std::chrono::nanoseconds &block_timeout = std::chrono::nanoseconds::zero()
+    )
+    requires can_convert_to<MessageType>
+      :
+      GenericReceiver<Converted>(
+        TopicInfo::get<MessageType>(topic_name),
+        node.environment.topic_map.getTopic<MessageType>(topic_name),
+        node,
+        buffer_size,
+        queue_policy,
+        block_timeout
+      ),
+      user_ptr(user_ptr),
+      message_buffer(GenericReceiver<Converted>::calculateBufferSize(buffer_size))
+    {
+      if constexpr (is_trivial_message<MessageType>) {
+        latest_update = &ReceiverBase::updateLatest;
+      }
+
+      // Only register the receiver once it is fully constructed, as the sender might access it right away.
+      GenericReceiver<Converted>::topic.addReceiver(this, is_const_message<MessageType>);
+    }
+
+    friend class Node;
+    friend class Sender<MessageType>;
+
+    template <typename... MessageTypes>
+    friend class Synchronizer;
+
+    void *const user_ptr;
+
+    /**
+     * @brief Function to update the latest value buffer of trivially copyable messages on each put operation.
+     * It is set by the receiver, as the sender does not know about the converted type of the receiver.
+     *
+     */
+    using LatestUpdateFunction = void (*)(void *, const Storage &, std::size_t);
+    LatestUpdateFunction latest_update = nullptr;
+
+    MessageBuffer<Storage> message_buffer;
+
+    /**
+     * @brief Store messages in the next slots of the buffer and publish them to readers.
+     * Depending on the queue policy, this might block or drop messages. Waiting readers are woken up once after all messages have been
+     * stored. Only the senders of the relevant topic may call this function.
+     *
+     * @param storages Messages to be stored. They will be moved out of the span.
+     * @param shared Whether multiple senders might store messages concurrently.
+     */
+    void store(std::span<std::shared_ptr<Storage>> storages, bool shared)
+    {
+      const typename GenericReceiver<Converted>::StoreGuard guard(*this, shared);
+
+      for (std::shared_ptr<Storage> &storage : storages) {
+        if (!GenericReceiver<Converted>::reserve()) {
+          GenericReceiver<Converted>::countDropped();
+          continue;
+        }
+
+        const std::size_t local_count = GenericReceiver<Converted>::count.load(std::memory_order_relaxed) + 1;
+
+        if (latest_update != nullptr) {
+          // The latest value must not be ahead of the committed messages, otherwise latest() would mark uncommitted messages as read.
+          // The additional reference keeps readers from moving the message out of the buffer while it is being converted.
+          const std::shared_ptr<Storage> reference = storage;
+
+          message_buffer.store(local_count, std::move(storage));
+          GenericReceiver<Converted>::commit(local_count);
+
+          latest_update(this, *reference, local_count);
+        } else {
+          message_buffer.store(local_count, std::move(storage));
+          GenericReceiver<Converted>::commit(local_count);
+        }
+      }
+
+      GenericReceiver<Converted>::publish();
+    }
+
+    /**
+     * @brief Store a message in the next slot of the buffer and publish it to readers.
+     * Depending on the queue policy, this might block or drop the message. Only the senders of the relevant topic may call this function.
+     *
+     * @param storage Message to be stored.
+     * @param shared Whether multiple senders might store messages concurrently.
+     */
+    void store(std::shared_ptr<Storage> &&storage, bool shared)
+    {
+      store(std::span<std::shared_ptr<Storage>>(&storage, 1), shared);
+    }
+
+    /**
+     * @brief Convert a message into the latest value buffer.
+     *
+     * @param receiver Pointer to the receiver.
+     * @param storage Message to be converted.
+     * @param local_count Receive count of the message.
+     */
+    static void updateLatest(void *receiver, const Storage &storage, std::size_t local_count)
+    {
+      ReceiverBase<MessageType> *self = reinterpret_cast<ReceiverBase<MessageType> *>(receiver);
+
+      LatestEntry entry;
+      entry.count = local_count;
+      Convert<MessageType::convertTo>::call(storage, entry.value, self->user_ptr);
+
+      self->latest_buffer.store(entry);
+    }
+
+  public:
+    ReceiverBase(ReceiverBase &) = delete;
+    ReceiverBase(ReceiverBase &&) = delete;
+
+    /**
+     * @brief Callback function to be called by the corresponding sender on each put operation.
+     *
+     */
+    class CallbackFunction
+    {
+    private:
+      using Wrapper = void (CallbackFunction::*)(const Storage &, void *, void *) const;
+
+    public:
+      template <typename DataType>
+      using Function = void (*)(const Converted &, DataType *);
+      using FunctionNoPtr = void (*)(const Converted &);
+
+      /**
+       * @brief Default constructor invalidating the object.
+       *
+       */
+      CallbackFunction() :
+        wrapper(&CallbackFunction::callInternal<MessageType>),
+        function(nullptr)
+      {}
+
+      /**
+       * @brief Construct a new callback function.
+       *
+       * @param function Function to be used as a callback function.
+       */
+      template <typename DataType>
+      CallbackFunction(Function<DataType> function) :
+        wrapper(&CallbackFunction::callInternal<MessageType>),
+        function(reinterpret_cast<Function<void>>(function))
+      {}
+
+      /**
+       * @brief Construct a new callback function.
+       *
+       * @param function Function to be used as a callback function.
+       */
+      CallbackFunction(FunctionNoPtr function) :
+        wrapper(&CallbackFunction::callInternal<MessageType>),
+        function(reinterpret_cast<Function<void>>(function))
+      {}
+
+      inline void call(const Storage &message, void *user_ptr, void *callback_ptr) const
+      {
+        (*this.*wrapper)(message, user_ptr, callback_ptr);
+      }
+
+      [[nodiscard]] bool valid() const
+      {
+        return function != nullptr;
+      }
+
+    private:
+      /**
+       * @brief Call the stored conversion function.
+       *
+       * @param message Message to compute.
+       * @param user_ptr User pointer to access generic external data.
+       */
+      template <typename ReceiverMessageType>
+      void callInternal(const typename ReceiverMessageType::Storage &message, void *user_ptr, void *callback_ptr) const
+      {
+        if (function == nullptr) {
+          return;
+        }
+
+        if constexpr (is_standard_message<ReceiverMessageType>) {
+          function(message, callback_ptr);
+        } else {
+          typename ReceiverMessageType::Converted converted;
+          Convert<ReceiverMessageType::convertTo>::call(message, converted, user_ptr);
+          function(converted, callback_ptr);
+        }
+      }
+
+      Wrapper wrapper;
+      Function<void> function;
+    };
+
+    /**
+     * @brief Destroy the Receiver object.
+     *
+     */
+    ~ReceiverBase() override
+    {
+      // Unblock a sender waiting for room in the buffer.
+      GenericReceiver<Converted>::invalidate();
+
+      GenericReceiver<Converted>::node.environment.topic_map.removeReceiver(GenericReceiver<Converted>::topic.name, this);
+    }
+
+    /**
+     * @brief Get the lastest message sent over the topic.
+     * This call is guaranteed to not block.
+     *
+     * @return Converted The latest message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     */
+    Converted latest() override
+    {
+      if constexpr (is_const_message<MessageType>) {
+        throw BadUsageException("You cannot call latest() in const messages.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      if (GenericReceiver<Converted>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      // Trivially copyable messages are converted by the sender, so that only a copy is required.
+      if constexpr (is_trivial_message<MessageType>) {
+        const LatestEntry entry = latest_buffer.load();
+
+        // The latest value is updated after its message has been committed, so it might be older than the last message read by next().
+        if (entry.count <= GenericReceiver<Converted>::read_count.load(std::memory_order_relaxed) && mode == Mode::next) {
+          throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<Converted>::node.getLogger());
+        }
+
+        // Queued messages remain unread until they are retrieved by next().
+        if (GenericReceiver<Converted>::queue_policy == QueuePolicy::overwrite_oldest) {
+          GenericReceiver<Converted>::markRead(entry.count);
+        }
+
+        mode = Mode::latest;
+
+        return entry.value;
+      }
+
+      Converted result;
+
+      std::shared_ptr<Storage> storage;
+      std::size_t local_count;
+
+      do {
+        local_count = GenericReceiver<Converted>::count.load(std::memory_order_acquire);
+
+        if (local_count == GenericReceiver<Converted>::read_count.load(std::memory_order_relaxed) && mode == Mode::next) {
+          throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<Converted>::node.getLogger());
+        }
+      } while (!message_buffer.load(local_count, storage));
+
+      if (!storage) {
+        throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      Convert<MessageType::convertTo>::call(*storage, result, user_ptr);
+
+      // Queued messages remain unread until they are retrieved by next().
+      if (GenericReceiver<Converted>::queue_policy == QueuePolicy::overwrite_oldest) {
+        GenericReceiver<Converted>::markRead(local_count);
+      }
+
+      mode = Mode::latest;
+
+      return result;
+    }
+
+    /**
+     * @brief Get the next message sent over the topic.
+     * @details This call might block. However, it is guaranteed that successive calls will yield different messages.
+     * Subsequent calls to latest() are unsafe.
+     *
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return Converted The next message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
+     */
+    Converted next(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()) override
+    {
+      if constexpr (is_const_message<MessageType>) {
+        throw BadUsageException("You cannot call next() in const messages.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      if (GenericReceiver<Converted>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
+
+      Converted result;
+
+      std::shared_ptr<Storage> storage;
+      std::size_t local_count;
+
+      while (true) {
+        if (GenericReceiver<Converted>::flush_flag.load()) {
+          throw TopicNoDataAvailableException("Topic was flushed during wait operation.", GenericReceiver<Converted>::node.getLogger());
+        }
+
+        std::size_t local_read_count = GenericReceiver<Converted>::read_count.load();
+        local_count = GenericReceiver<Converted>::count.load(std::memory_order_acquire);
+
+        if (local_count != local_read_count) {
+          if (GenericReceiver<Converted>::queue_policy == QueuePolicy::overwrite_oldest) {
+            if (message_buffer.load(local_count, storage) && storage) {
+              GenericReceiver<Converted>::markRead(local_count);
+              break;
+            }
+          } else {
+            const std::size_t lag = local_count - local_read_count;
+
+            // Retrieve the oldest unread message and claim it before any other reader does.
+            local_count = local_read_count + 1;
+
+            if (message_buffer.load(local_count, storage) && storage
+                && GenericReceiver<Converted>::read_count.compare_exchange_strong(local_read_count, local_count)) {
+              GenericReceiver<Converted>::topic.counters.recordLag(lag);
+
+              // Wake up a sender waiting for room in the buffer.
+              GenericReceiver<Converted>::notify();
+              break;
+            }
+          }
+
+          continue;
+        }
+
+        if (!GenericReceiver<Converted>::waitForUpdate(local_count, timeout_duration, timeout_point)) {
+          throw TopicTimeoutException("Receiver topic timeout.", GenericReceiver<Converted>::node.getLogger());
+        }
+      }
+
+      extract(local_count, storage, result);
+
+      mode = Mode::next;
+
+      return result;
+    }
+
+    /**
+     * @brief Get all unread messages sent over the topic, oldest first.
+     * This call blocks until at least one unread message is available. The messages are moved out of the internal buffer where
+     * possible. Subsequent calls to latest() are unsafe.
+     *
+     * @param max_count Maximum number of messages to be returned. It must be at least 1.
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return std::vector<Converted> Unread messages sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
+     */
+    std::vector<Converted> nextBatch(
+      std::size_t max_count, const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()
+    ) override
+    {
+      if (max_count == 0) {
+        throw InvalidArgumentException("The maximum batch size must be at least 1.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
+
+      std::vector<Converted> result;
+
+      while (true) {
+        const std::size_t local_count = GenericReceiver<Converted>::count.load();
+
+        if (drainInto(std::back_inserter(result), max_count) != 0) {
+          return result;
+        }
+
+        if (!GenericReceiver<Converted>::waitForUpdate(local_count, timeout_duration, timeout_point)) {
+          throw TopicTimeoutException("Receiver topic timeout.", GenericReceiver<Converted>::node.getLogger());
+        }
+      }
+    }
+
+    /**
+     * @brief Write all unread messages sent over the topic to an output iterator, oldest first.
+     * This call is guaranteed to not block. The messages are moved out of the internal buffer where possible. Subsequent calls to latest()
+     * are unsafe.
+     *
+     * @tparam OutputIt Type of the output iterator.
+     * @param output Output iterator to write the messages to.
+     * @param max_count Maximum number of messages to be written.
+     * @return std::size_t Number of messages written.
+     * @throw TopicNoDataAvailableException When the topic has been flushed.
+     */
+    template <typename OutputIt>
+    std::size_t drainInto(OutputIt output, std::size_t max_count = std::numeric_limits<std::size_t>::max())
+    {
+      if constexpr (is_const_message<MessageType>) {
+        throw BadUsageException("You cannot call drainInto() in const messages.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      if (GenericReceiver<Converted>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<Converted>::node.getLogger());
+      }
+
+      std::vector<std::shared_ptr<Storage>> storages;
+      const std::size_t first_count = GenericReceiver<Converted>::claimUnread(message_buffer, storages, max_count);
+
+      for (std::size_t i = 0; i < storages.size(); ++i) {
+        Converted result;
+        extract(first_count + i, storages[i], result);
+
+        *output = std::move(result);
+        ++output;
+      }
+
+      if (!storages.empty()) {
+        mode = Mode::next;
+      }
+
+      return storages.size();
     }
 
-  protected:
-    GenericReceiver(TopicInfo topic_info, TopicMap::Topic &topic, Node &node, std::size_t buffer_size) :
-      topic_info(std::move(topic_info)),
-      topic(topic),
-      node(node),
-      index_mask(calculateBufferMask(buffer_size)),
-      count(index_mask)
+    /**
+     * @brief Register a callback function.
+     *
+     * @param function Callback function to be registered.
+     * @param policy Launch policy to control whether the callback will be launched in a new thread. If your callback is expected to only
+     * take up a short amount of time, change this to lbot::ExecutionPolicy::serial.
+     */
+    void setCallback(CallbackFunction::FunctionNoPtr function, ExecutionPolicy policy = ExecutionPolicy::serial)
     {
-      next_count = index_mask;
-      flush_flag = true;
+      if (callback.valid()) {
+        throw BadUsageException("A callback has already been registered.");
+      }
+
+      callback = function;
+      callback_ptr = nullptr;
+      callback_policy = (policy == ExecutionPolicy::parallel) ? std::launch::async : std::launch::deferred;
+      callback_executor = (policy == ExecutionPolicy::pooled) ? &Manager::get()->getExecutor() : nullptr;
     }
 
-    friend class TopicMap;
+    /**
+     * @brief Register a callback function to be executed by the supplied executor.
+     *
+     * @param function Callback function to be registered.
+     * @param executor Executor on which the callback will be executed. The executor must outlive the receiver.
+     */
+    void setCallback(CallbackFunction::FunctionNoPtr function, Executor &executor)
+    {
+      if (callback.valid()) {
+        throw BadUsageException("A callback has already been registered.");
+      }
+
+      callback = function;
+      callback_ptr = nullptr;
+      callback_policy = std::launch::deferred;
+      callback_executor = &executor;
+    }
 
     /**
-     * @brief Calculate the internal buffer size required to satisfy the provided buffer size.
-     * This will either be the provided buffer size itself or the next power of 2.
+     * @brief Register a callback function.
+     *
+     * @param function Callback function to be registered.
+     * @param user_ptr User pointer to be supplied on callbacks.
+     * @param policy Launch policy to control whether the callback will be launched in a new thread. If your callback is expected take up
+     * considerable resources, change this to lbot::ExecutionPolicy::parallel.
+     */
+    template <typename DataType>
+    void setCallback(
+      CallbackFunction::template Function<DataType> function,
+      DataType *user_ptr,
+      ExecutionPolicy policy = ExecutionPolicy::serial
+    )
+    {
+      if (callback.valid()) {
+        throw BadUsageException("A callback has already been registered.");
+      }
+
+      callback = function;
+      callback_ptr = reinterpret_cast<void *>(user_ptr);
+      callback_policy = (policy == ExecutionPolicy::parallel) ? std::launch::async : std::launch::deferred;
+      callback_executor = (policy == ExecutionPolicy::pooled) ? &Manager::get()->getExecutor() : nullptr;
+    }
+
+    /**
+     * @brief Register a callback function to be executed by the supplied executor.
+     *
+     * @param function Callback function to be registered.
+     * @param user_ptr User pointer to be supplied on callbacks.
+     * @param executor Executor on which the callback will be executed. The executor must outlive the receiver.
+     */
+    template <typename DataType>
+    void setCallback(CallbackFunction::template Function<DataType> function, DataType *user_ptr, Executor &executor)
+    {
+      if (callback.valid()) {
+        throw BadUsageException("A callback has already been registered.");
+      }
+
+      callback = function;
+      callback_ptr = reinterpret_cast<void *>(user_ptr);
+      callback_policy = std::launch::deferred;
+      callback_executor = &executor;
+    }
+
+  private:
+    /**
+     * @brief Convert a message that has been claimed by the reader.
+     * The message is only moved out of the buffer if it is neither shared with other receivers nor accessed by other readers.
+     *
+     * @param local_count Receive count of the message.
+     * @param storage Claimed message.
+     * @param result Object to store the converted message in.
+     */
+    void extract(std::size_t local_count, std::shared_ptr<Storage> &storage, Converted &result)
+    {
+      if constexpr (can_move_from<MessageType>) {
+        bool exclusive = false;
+
+        if (storage.use_count() == 2) {
+          message_buffer.release(local_count, storage);
+
+          exclusive = storage.use_count() == 1;
+          std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        if (exclusive) {
+          Move<MessageType::moveTo>::call(std::move(*storage), result, user_ptr);
+          return;
+        }
+      }
+
+      Convert<MessageType::convertTo>::call(*storage, result, user_ptr);
+    }
+
+    CallbackFunction callback;
+    void *callback_ptr;
+    std::launch callback_policy;
+    Executor *callback_executor = nullptr;
+
+    enum class Mode : u8
+    {
+      latest,
+      next,
+    } mode = Mode::latest;
+
+    struct LatestEntry
+    {
+      std::size_t count;
+      Converted value;
+    };
+
+    // This must remain the last member, as its layout depends on the converted type.
+    [[no_unique_address]] std::conditional_t<is_trivial_message<MessageType>, SeqLock<LatestEntry>, std::monostate> latest_buffer;
+  };
+
+  // Wrapper classes to allow flatbuffer types to also work as template arguments.
+  template <typename MessageType>
+  class Receiver final : public ReceiverBase<MessageType>
+  {
+  public:
+    using Super = ReceiverBase<MessageType>;
+    using Ptr = std::unique_ptr<Receiver<MessageType>>;
+
+    template <typename... Args>
+    explicit Receiver(Args &&...args) :
+      Super(std::forward<Args>(args)...){};
+  };
+
+  template <typename FlatbufferType>
+  requires is_flatbuffer<FlatbufferType>
+  class Receiver<FlatbufferType> final : public ReceiverBase<Message<FlatbufferType>>
+  {
+  public:
+    using Super = ReceiverBase<Message<FlatbufferType>>;
+    using Ptr = std::unique_ptr<Receiver<FlatbufferType>>;
+
+    template <typename... Args>
+    explicit Receiver(Args &&...args) :
+      Super(std::forward<Args>(args)...){};
+  };
+
+  /**
+   * @brief Class to receive serialized messages from a topic without unpacking them.
+   * @details The sender serializes each message once and shares the resulting buffer among all view receivers and plugins. The contents of
+   * the message are accessed through the generated accessor table of the flatbuffer.
+   *
+   * @tparam FlatbufferType Type of the flatbuffer table sent over the topic.
+   */
+  template <typename FlatbufferType>
+  requires is_flatbuffer<FlatbufferType>
+  class ViewReceiver final : public GenericReceiver<MessageView<FlatbufferType>>
+  {
+  public:
+    using View = MessageView<FlatbufferType>;
+    using Ptr = std::unique_ptr<ViewReceiver<FlatbufferType>>;
+
+  private:
+    /**
+     * @brief Construct a new View Receiver object.
+     *
+     * @param topic_name Name of the topic.
+     * @param node Reference to the parent node.
+     * @param buffer_size Size of the internal receiver buffer. It must be at least 4 and should ideally be a power of 2.
+     * @param queue_policy Policy to handle new messages when the consumer falls behind.
+     * @param block_timeout Maximum duration a sender will be blocked when using QueuePolicy::block_sender. A duration of zero will block
+     * indefinitely.
+     */
+    ViewReceiver(
+      const std::string &topic_name,
+      Node &node,
+      std::size_t buffer_size = 4,
+      QueuePolicy queue_policy = QueuePolicy::overwrite_oldest,
+      const std::chrono::nanoseconds &block_timeout = std::chrono::nanoseconds::zero()
+    ) :
+      GenericReceiver<View>(
+        TopicInfo::get<Message<FlatbufferType>>(topic_name),
+        node.environment.topic_map.getTopic<Message<FlatbufferType>>(topic_name),
+        node,
+        buffer_size,
+        queue_policy,
+        block_timeout
+      ),
+      message_buffer(GenericReceiver<View>::calculateBufferSize(buffer_size))
+    {
+      // Only register the receiver once it is fully constructed, as the sender might access it right away.
+      GenericReceiver<View>::topic.addViewReceiver(this);
+    }
+
+    friend class Node;
+
+    template <typename MessageType>
+    requires is_message<MessageType>
+    friend class SenderBase;
+
+    MessageBuffer<const View> message_buffer;
+
+    /**
+     * @brief Store messages in the next slots of the buffer and publish them to readers.
+     * Depending on the queue policy, this might block or drop messages. Waiting readers are woken up once after all messages have been
+     * stored. Only the senders of the relevant topic may call this function.
+     *
+     * @param views Messages to be stored.
+     * @param shared Whether multiple senders might store messages concurrently.
+     */
+    void store(std::span<const std::shared_ptr<const View>> views, bool shared)
+    {
+      const typename GenericReceiver<View>::StoreGuard guard(*this, shared);
+
+      for (const std::shared_ptr<const View> &view : views) {
+        if (!GenericReceiver<View>::reserve()) {
+          GenericReceiver<View>::countDropped();
+          continue;
+        }
+
+        const std::size_t local_count = GenericReceiver<View>::count.load(std::memory_order_relaxed) + 1;
+
+        message_buffer.store(local_count, std::shared_ptr<const View>(view));
+        GenericReceiver<View>::commit(local_count);
+      }
+
+      GenericReceiver<View>::publish();
+    }
+
+  public:
+    ViewReceiver(ViewReceiver &) = delete;
+    ViewReceiver(ViewReceiver &&) = delete;
+
+    /**
+     * @brief Destroy the View Receiver object.
+     *
+     */
+    ~ViewReceiver() override
+    {
+      // Unblock a sender waiting for room in the buffer.
+      GenericReceiver<View>::invalidate();
+
+      GenericReceiver<View>::node.environment.topic_map.removeReceiver(GenericReceiver<View>::topic.name, this);
+    }
+
+    /**
+     * @brief Get the lastest message sent over the topic.
+     * This call is guaranteed to not block.
+     *
+     * @return View The latest message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     */
+    View latest() override
+    {
+      if (GenericReceiver<View>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<View>::node.getLogger());
+      }
+
+      std::shared_ptr<const View> view;
+      std::size_t local_count;
+
+      do {
+        local_count = GenericReceiver<View>::count.load(std::memory_order_acquire);
+
+        if (local_count == GenericReceiver<View>::read_count.load(std::memory_order_relaxed) && mode == Mode::next) {
+          throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<View>::node.getLogger());
+        }
+      } while (!message_buffer.load(local_count, view));
+
+      if (!view) {
+        throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<View>::node.getLogger());
+      }
+
+      // Queued messages remain unread until they are retrieved by next().
+      if (GenericReceiver<View>::queue_policy == QueuePolicy::overwrite_oldest) {
+        GenericReceiver<View>::markRead(local_count);
+      }
+
+      mode = Mode::latest;
+
+      return *view;
+    }
+
+    /**
+     * @brief Get the next message sent over the topic.
+     * @details This call might block. However, it is guaranteed that successive calls will yield different messages.
+     * Subsequent calls to latest() are unsafe.
+     *
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return View The next message sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
+     */
+    View next(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()) override
+    {
+      if (GenericReceiver<View>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<View>::node.getLogger());
+      }
+
+      const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
+
+      std::shared_ptr<const View> view;
+
+      while (true) {
+        if (GenericReceiver<View>::flush_flag.load()) {
+          throw TopicNoDataAvailableException("Topic was flushed during wait operation.", GenericReceiver<View>::node.getLogger());
+        }
+
+        std::size_t local_read_count = GenericReceiver<View>::read_count.load();
+        std::size_t local_count = GenericReceiver<View>::count.load(std::memory_order_acquire);
+
+        if (local_count != local_read_count) {
+          if (GenericReceiver<View>::queue_policy == QueuePolicy::overwrite_oldest) {
+            if (message_buffer.load(local_count, view) && view) {
+              GenericReceiver<View>::markRead(local_count);
+              break;
+            }
+          } else {
+            const std::size_t lag = local_count - local_read_count;
+
+            // Retrieve the oldest unread message and claim it before any other reader does.
+            local_count = local_read_count + 1;
+
+            if (message_buffer.load(local_count, view) && view
+                && GenericReceiver<View>::read_count.compare_exchange_strong(local_read_count, local_count)) {
+              GenericReceiver<View>::topic.counters.recordLag(lag);
+
+              // Wake up a sender waiting for room in the buffer.
+              GenericReceiver<View>::notify();
+              break;
+            }
+          }
+
+          continue;
+        }
+
+        if (!GenericReceiver<View>::waitForUpdate(local_count, timeout_duration, timeout_point)) {
+          throw TopicTimeoutException("Receiver topic timeout.", GenericReceiver<View>::node.getLogger());
+        }
+      }
+
+      mode = Mode::next;
+
+      return *view;
+    }
+
+    /**
+     * @brief Get all unread messages sent over the topic, oldest first.
+     * This call blocks until at least one unread message is available. Subsequent calls to latest() are unsafe.
      *
-     * @param buffer_size Provided buffer size of the receiver.
-     * @return std::size_t Internal buffer size.
+     * @param max_count Maximum number of messages to be returned. It must be at least 1.
+     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
+     * @return std::vector<View> Unread messages sent over the topic.
+     * @throw TopicNoDataAvailableException When the topic has no valid data available.
+     * @throw TopicTimeoutException When the timeout is exceeded.
      */
-    std::size_t calculateBufferSize(std::size_t buffer_size)
+    std::vector<View> nextBatch(
+      std::size_t max_count, const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()
+    ) override
     {
-      if (buffer_size < 4) {
-        throw InvalidArgumentException("The buffer size for a Receiver must be at least 4.", node.getLogger());
+      if (max_count == 0) {
+        throw InvalidArgumentException("The maximum batch size must be at least 1.", GenericReceiver<View>::node.getLogger());
       }
 
-      std::size_t mask = std::size_t(1) << ((sizeof(std::size_t) * 8) - 1);
+      const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
+
+      std::vector<View> result;
 
       while (true) {
-        if (mask & buffer_size) {
-          if (mask ^ buffer_size) {
-            return mask << 1;
-          } else {
-            return mask;
-          }
+        const std::size_t local_count = GenericReceiver<View>::count.load();
+
+        if (drainInto(std::back_inserter(result), max_count) != 0) {
+          return result;
         }
 
-        mask >>= 1;
+        if (!GenericReceiver<View>::waitForUpdate(local_count, timeout_duration, timeout_point)) {
+          throw TopicTimeoutException("Receiver topic timeout.", GenericReceiver<View>::node.getLogger());
+        }
       }
     }
 
     /**
-     * @brief Calculate the buffer mask used internally to compute a buffer index from a receive count.
+     * @brief Write all unread messages sent over the topic to an output iterator, oldest first.
+     * This call is guaranteed to not block. Subsequent calls to latest() are unsafe.
      *
-     * @param buffer_size Provided buffer size of the receiver.
-     * @return std::size_t Internal buffer mask.
+     * @tparam OutputIt Type of the output iterator.
+     * @param output Output iterator to write the messages to.
+     * @param max_count Maximum number of messages to be written.
+     * @return std::size_t Number of messages written.
+     * @throw TopicNoDataAvailableException When the topic has been flushed.
      */
-    std::size_t calculateBufferMask(std::size_t buffer_size)
+    template <typename OutputIt>
+    std::size_t drainInto(OutputIt output, std::size_t max_count = std::numeric_limits<std::size_t>::max())
     {
-      return calculateBufferSize(buffer_size) - 1;
-    }
+      if (GenericReceiver<View>::flush_flag.load()) {
+        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<View>::node.getLogger());
+      }
 
-    const TopicInfo topic_info;
-    TopicMap::Topic &topic;
+      std::vector<std::shared_ptr<const View>> views;
+      GenericReceiver<View>::claimUnread(message_buffer, views, max_count);
 
-    Node &node;
+      for (const std::shared_ptr<const View> &view : views) {
+        *output = *view;
+        ++output;
+      }
 
-    const std::size_t index_mask;
+      if (!views.empty()) {
+        mode = Mode::next;
+      }
 
-    std::atomic<std::size_t> count;
-    std::condition_variable condition;
-    std::size_t next_count;
-    bool flush_flag;
+      return views.size();
+    }
+
+  private:
+    enum class Mode : u8
+    {
+      latest,
+      next,
+    } mode = Mode::latest;
   };
 
   /**
-   * @brief Generic class to receive messages from a topic.
+   * @brief Class to match messages sent over multiple topics by their timestamps.
+   * @details The synchronizer claims the messages of its receivers directly from their buffers. Messages are only converted once they have
+   * been matched, so that unmatched messages do not cause any conversion work. The callback is called by the sender whose message completes
+   * a match and only one match is processed at a time. Messages sent over each topic are expected to be in chronological order.
    *
-   * @tparam MessageType Type of the messages sent over the topic.
+   * @tparam MessageTypes Types of the messages sent over the topics.
    */
-  template <typename MessageType>
-  requires is_message<MessageType>
-  class ReceiverBase : public GenericReceiver<typename MessageType::Converted>
+  template <typename... MessageTypes>
+  class Synchronizer final
   {
+    static_assert(sizeof...(MessageTypes) >= 2, "A synchronizer requires at least two topics.");
+
+    static constexpr std::size_t topic_count = sizeof...(MessageTypes);
+
+    template <std::size_t I>
+    using MessageType = std::tuple_element_t<I, std::tuple<MessageTypes...>>;
+
+    template <typename T>
+    using Listener = typename Receiver<T>::Super::UpdateListener;
+
   public:
-    using Storage = typename MessageType::Storage;
-    using Converted = typename MessageType::Converted;
+    using Ptr = std::unique_ptr<Synchronizer<MessageTypes...>>;
 
-    template <auto *Function>
-    using Convert = ConversionFunction<Function>;
-    template <auto *Function>
-    using Move = MoveFunction<Function>;
+    template <typename DataType>
+    using Function = void (*)(const typename Receiver<MessageTypes>::Converted &..., DataType *);
+    using FunctionNoPtr = void (*)(const typename Receiver<MessageTypes>::Converted &...);
 
   private:
     /**
-     * @brief Construct a new Receiver object.
+     * @brief Construct a new Synchronizer object.
      *
-     * @param topic_name Name of the topic.
+     * @param topic_names Names of the topics in the order of the message types.
      * @param node Reference to the parent node.
-     * @param user_ptr User pointer to be used by the conversion function.
-     * @param buffer_size Size of the internal receiver buffer. It must be at least 4 and should ideally be a power of 2.
+     * @param policy Policy to control how messages are matched.
+     * @param max_interval Maximum interval between the timestamps of matched messages when using SyncPolicy::approximate.
+     * @param queue_size Maximum number of unmatched messages kept per topic. It must be at least 4.
+     * @throw InvalidArgumentException When the maximum interval is negative.
      */
-    ReceiverBase(const std::string &topic_name, Node &node, void *user_ptr = nullptr, std::size_t buffer_size = 4)
-    requires can_convert_to<MessageType>
-      :
-      GenericReceiver<Converted>(
-        TopicInfo::get<MessageType>(topic_name),
-        node.environment.topic_map.addReceiver<MessageType>(topic_name, this),
-        node,
-        buffer_size
-      ),
-      user_ptr(user_ptr),
-      message_buffer(GenericReceiver<Converted>::calculateBufferSize(buffer_size))
-    {}
+    Synchronizer(
+      const std::array<std::string, topic_count> &topic_names,
+      Node &node,
+      SyncPolicy policy = SyncPolicy::exact,
+      const std::chrono::nanoseconds &max_interval = std::chrono::nanoseconds::zero(),
+      std::size_t queue_size = 16
+    ) :
+      tolerance((policy == SyncPolicy::exact) ? std::chrono::nanoseconds::zero() : max_interval),
+      policy(policy),
+      queue_size(queue_size),
+      active(false),
+      busy(false),
+      pending(false),
+      dropped_count(0)
+    {
+      if (max_interval < std::chrono::nanoseconds::zero()) {
+        throw InvalidArgumentException("The maximum interval of a synchronizer must not be negative.", node.getLogger());
+      }
+
+      forEach([&](auto index) {
+        std::get<index>(receivers) = node.addReceiver<MessageType<index>>(topic_names[index], nullptr, queue_size);
+      });
+
+      // Only listen for updates once all receivers exist, as a sender might notify the synchronizer right away.
+      forEach([&](auto index) {
+        std::get<index>(listeners) =
+          std::make_unique<Listener<MessageType<index>>>(*std::get<index>(receivers), &Synchronizer::notify, this);
+      });
+    }
 
     friend class Node;
-    friend class Sender<MessageType>;
 
-    void *const user_ptr;
+  public:
+    Synchronizer(const Synchronizer &) = delete;
 
     /**
-     * @brief Internal message buffer.
+     * @brief Destroy the Synchronizer object.
      *
      */
-    class MessageBuffer
+    ~Synchronizer()
     {
-    public:
-      struct MessageData
-      {
-        Storage message;
-        std::mutex mutex;
-        bool update_flag = false;
-      };
+      // Stop all notifications before the receivers are destroyed.
+      forEach([&](auto index) {
+        std::get<index>(listeners).reset();
+      });
+    }
 
-      /**
-       * @brief Construct a new Message Buffer object given its size.
-       *
-       * @param size Size of the message buffer.
-       */
-      explicit MessageBuffer(std::size_t size) :
-        size(size)
-      {
-        buffer = allocator.allocate(size);
+    /**
+     * @brief Register a callback function to be called with each set of matched messages.
+     *
+     * @param function Callback function to be registered.
+     * @throw BadUsageException When a callback has already been registered.
+     */
+    void setCallback(FunctionNoPtr function)
+    {
+      setCallback(reinterpret_cast<Function<void>>(function), static_cast<void *>(nullptr));
+    }
 
-        for (std::size_t i = 0; i < size; ++i) {
-          std::construct_at<MessageData>(buffer + i);
-        }
+    /**
+     * @brief Register a callback function to be called with each set of matched messages.
+     *
+     * @param function Callback function to be registered.
+     * @param user_ptr User pointer to be supplied on callbacks.
+     * @throw BadUsageException When a callback has already been registered.
+     */
+    template <typename DataType>
+    void setCallback(Function<DataType> function, DataType *user_ptr)
+    {
+      if (active.load()) {
+        throw BadUsageException("A callback has already been registered.");
       }
 
-      /**
-       * @brief Destroy the Message Buffer object.
-       *
-       */
-      ~MessageBuffer()
-      {
-        for (std::size_t i = 0; i < size; ++i) {
-          std::destroy_at<MessageData>(buffer + i);
-        }
-
-        allocator.deallocate(buffer, size);
-      }
+      callback = reinterpret_cast<Function<void>>(function);
+      callback_ptr = reinterpret_cast<void *>(user_ptr);
+      active.store(true);
 
-      /**
-       * @brief Access elements in the buffer.
-       *
-       * @param index Index of the requested element.
-       * @return MessageData& Reference to the requested element.
-       */
-      MessageData &operator[](std::size_t index)
-      {
-        return buffer[index];
-      }
+      // Match the messages that have been received so far.
+      update();
+    }
 
-    private:
-      MessageData *buffer;
-      std::allocator<MessageData> allocator;
+    /**
+     * @brief Get the number of messages that have been discarded without being matched.
+     *
+     * @return u64 Number of discarded messages.
+     */
+    [[nodiscard]] inline u64 getDroppedCount() const
+    {
+      return dropped_count.load(std::memory_order_relaxed);
+    }
 
-      const std::size_t size;
+  private:
+    template <typename StorageType>
+    struct Entry
+    {
+      std::size_t count;
+      std::shared_ptr<StorageType> storage;
     };
 
-    MessageBuffer message_buffer;
-
-  public:
-    ReceiverBase(ReceiverBase &) = delete;
-    ReceiverBase(ReceiverBase &&) = delete;
-
     /**
-     * @brief Callback function to be called by the corresponding sender on each put operation.
+     * @brief Call a function for the index of each topic.
      *
+     * @param function Function to be called with a std::integral_constant holding the index.
      */
-    class CallbackFunction
+    template <typename F>
+    static void forEach(F &&function)
     {
-    private:
-      using Wrapper = void (CallbackFunction::*)(const Storage &, void *, void *) const;
-
-    public:
-      template <typename DataType>
-      using Function = void (*)(const Converted &, DataType *);
-      using FunctionNoPtr = void (*)(const Converted &);
-
-      /**
-       * @brief Default constructor invalidating the object.
-       *
-       */
-      CallbackFunction() :
-        wrapper(&CallbackFunction::callInternal<MessageType>),
-        function(nullptr)
-      {}
-
-      /**
-       * @brief Construct a new callback function.
-       *
-       * @param function Function to be used as a callback function.
-       */
-      template <typename DataType>
-      CallbackFunction(Function<DataType> function) :
-        wrapper(&CallbackFunction::callInternal<MessageType>),
-        function(reinterpret_cast<Function<void>>(function))
-      {}
-
-      /**
-       * @brief Construct a new callback function.
-       *
-       * @param function Function to be used as a callback function.
-       */
-      CallbackFunction(FunctionNoPtr function) :
-        wrapper(&CallbackFunction::callInternal<MessageType>),
-        function(reinterpret_cast<Function<void>>(function))
-      {}
+      [&function]<std::size_t... I>(std::index_sequence<I...>) {
+        (function(std::integral_constant<std::size_t, I>()), ...);
+      }(std::index_sequence_for<MessageTypes...>());
+    }
 
-      inline void call(const Storage &message, void *user_ptr, void *callback_ptr) const
-      {
-        (*this.*wrapper)(message, user_ptr, callback_ptr);
-      }
+    static void notify(void *synchronizer)
+    {
+      reinterpret_cast<Synchronizer<MessageTypes...> *>(synchronizer)->update();
+    }
 
-      [[nodiscard]] bool valid() const
-      {
-        return function != nullptr;
-      }
+    /**
+     * @brief Process all updates of the receivers.
+     * When another thread is already processing updates, it will also process this update, so that a sender is never blocked by the
+     * callback of another sender. This also allows the callback to send messages over the synchronized topics.
+     *
+     */
+    void update()
+    {
+      pending.store(true);
 
-    private:
-      /**
-       * @brief Call the stored conversion function.
-       *
-       * @param message Message to compute.
-       * @param user_ptr User pointer to access generic external data.
-       */
-      template <typename ReceiverMessageType>
-      void callInternal(const typename ReceiverMessageType::Storage &message, void *user_ptr, void *callback_ptr) const
-      {
-        if (function == nullptr) {
+      while (pending.load()) {
+        if (busy.exchange(true, std::memory_order_acquire)) {
           return;
         }
 
-        if constexpr (is_standard_message<ReceiverMessageType>) {
-          function(message, callback_ptr);
-        } else {
-          typename ReceiverMessageType::Converted converted;
-          Convert<ReceiverMessageType::convertTo>::call(message, converted, user_ptr);
-          function(converted, callback_ptr);
+        try {
+          while (pending.exchange(false)) {
+            process();
+          }
+        } catch (...) {
+          busy.store(false, std::memory_order_release);
+          throw;
         }
-      }
-
-      Wrapper wrapper;
-      Function<void> function;
-    };
 
-    /**
-     * @brief Destroy the Receiver object.
-     *
-     */
-    ~ReceiverBase() override
-    {
-      GenericReceiver<Converted>::node.environment.topic_map.removeReceiver(GenericReceiver<Converted>::topic.name, this);
+        busy.store(false, std::memory_order_release);
+      }
     }
 
     /**
-     * @brief Get the lastest message sent over the topic.
-     * This call is guaranteed to not block.
+     * @brief Claim the unread messages of all receivers and invoke the callback for every match.
      *
-     * @return Converted The latest message sent over the topic.
-     * @throw TopicNoDataAvailableException When the topic has no valid data available.
      */
-    Converted latest() override
+    void process()
     {
-      if constexpr (is_const_message<MessageType>) {
-        throw BadUsageException("You cannot call latest() in const messages.", GenericReceiver<Converted>::node.getLogger());
+      if (!active.load()) {
+        return;
       }
 
-      if (GenericReceiver<Converted>::flush_flag) {
-        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<Converted>::node.getLogger());
-      }
+      forEach([this](auto index) {
+        claim<index>();
+      });
 
-      Converted result;
+      while (true) {
+        // Every topic must provide a message for a match.
+        bool complete = true;
+        Clock::time_point pivot = Clock::time_point::min();
 
-      const std::size_t local_count = GenericReceiver<Converted>::count.load(std::memory_order_acquire);
-      const std::size_t index = local_count & GenericReceiver<Converted>::index_mask;
+        forEach([&](auto index) {
+          if (std::get<index>(queues).empty()) {
+            complete = false;
+          } else {
+            pivot = std::max(pivot, std::get<index>(queues).front().storage->getTimestamp());
+          }
+        });
 
-      if (!message_buffer[index].update_flag && mode == Mode::next) {
-        throw TopicNoDataAvailableException("No new data after next() call.", GenericReceiver<Converted>::node.getLogger());
-      }
+        if (!complete) {
+          return;
+        }
 
-      {
-        std::lock_guard guard(message_buffer[index].mutex);
-        Convert<MessageType::convertTo>::call(message_buffer[index].message, result, user_ptr);
-        message_buffer[index].update_flag = false;
-      }
+        std::array<std::size_t, topic_count> indices;
+        std::array<Clock::time_point, topic_count> timestamps;
 
-      mode = Mode::latest;
+        forEach([&](auto index) {
+          complete = complete && findCandidate<index>(pivot, indices[index], timestamps[index]);
+        });
 
-      return result;
-    }
+        // A later message might still be closer to the newest message.
+        if (!complete) {
+          return;
+        }
 
-    /**
-     * @brief Get the next message sent over the topic.
-     * @details This call might block. However, it is guaranteed that successive calls will yield different messages.
-     * Subsequent calls to latest() are unsafe.
-     *
-     * @param timeout_duration Duration of the timeout after which an exception will be thrown.
-     * @return Converted The next message sent over the topic.
-     * @throw TopicNoDataAvailableException When the topic has no valid data available.
-     * @throw TopicTimeoutException When the timeout is exceeded.
+        const auto [oldest, newest] = std::minmax_element(timestamps.begin(), timestamps.end());
+
+        if (*newest - *oldest <= tolerance) {
+          emit(indices);
+
+          forEach([&](auto index) {
+            discard<index>(indices[index]);
+            std::get<index>(queues).pop_front();
+          });
+        } else {
+          const std::size_t oldest_index = oldest - timestamps.begin();
+
+          // The oldest candidate cannot be matched anymore, as all other topics have already advanced beyond it.
+          forEach([&](auto index) {
+            if (index == oldest_index) {
+              discard<index>(indices[index] + 1);
+            }
+          });
+        }
+      }
+    }
+
+    /**
+     * @brief Move the unread messages of a receiver into its queue.
+     *
+     * @tparam I Index of the topic.
      */
-    Converted next(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero()) override
+    template <std::size_t I>
+    void claim()
     {
-      if constexpr (is_const_message<MessageType>) {
-        throw BadUsageException("You cannot call next() in const messages.", GenericReceiver<Converted>::node.getLogger());
-      }
+      auto &receiver = *std::get<I>(receivers);
+      auto &queue = std::get<I>(queues);
 
-      if (GenericReceiver<Converted>::flush_flag) {
-        throw TopicNoDataAvailableException("Topic was flushed.", GenericReceiver<Converted>::node.getLogger());
+      // Stale data of a flushed receiver is never matched.
+      if (receiver.flush_flag.load()) {
+        return;
       }
 
-      const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
-
-      Converted result;
+      std::vector<std::shared_ptr<typename Receiver<MessageType<I>>::Storage>> storages;
+      const std::size_t first_count = receiver.claimUnread(receiver.message_buffer, storages, std::numeric_limits<std::size_t>::max());
 
-      std::size_t local_count = GenericReceiver<Converted>::next_count;
-      std::size_t index;
+      for (std::size_t i = 0; i < storages.size(); ++i) {
+        queue.push_back({.count = first_count + i, .storage = std::move(storages[i])});
+      }
 
-      {
-        std::unique_lock<std::mutex> lock;
+      if (queue.size() > queue_size) {
+        discard<I>(queue.size() - queue_size);
+      }
+    }
 
-        while (true) {
-          if (GenericReceiver<Converted>::flush_flag) {
-            throw TopicNoDataAvailableException("Topic was flushed during wait operation.", GenericReceiver<Converted>::node.getLogger());
-          }
+    /**
+     * @brief Find the message of a topic to be matched with the newest of the oldest messages of all topics.
+     *
+     * @tparam I Index of the topic.
+     * @param pivot Timestamp to be matched.
+     * @param index Index of the candidate within the queue.
+     * @param timestamp Timestamp of the candidate.
+     * @return true When the candidate is final.
+     * @return false When no message at or after the pivot has been received yet.
+     */
+    template <std::size_t I>
+    bool findCandidate(Clock::time_point pivot, std::size_t &index, Clock::time_point &timestamp) const
+    {
+      const auto &queue = std::get<I>(queues);
 
-          local_count = GenericReceiver<Converted>::count.load(std::memory_order_acquire);
-          index = local_count & GenericReceiver<Converted>::index_mask;
+      const auto iterator = std::find_if(queue.begin(), queue.end(), [pivot](const auto &entry) -> bool {
+        return entry.storage->getTimestamp() >= pivot;
+      });
 
-          if (lock.mutex() != &message_buffer[index].mutex) {
-            lock = std::unique_lock(message_buffer[index].mutex);
-          }
+      if (iterator == queue.end()) {
+        return false;
+      }
 
-          if (message_buffer[index].update_flag) {
-            break;
-          }
+      index = iterator - queue.begin();
+      timestamp = iterator->storage->getTimestamp();
 
-          if (timeout_duration == std::chrono::nanoseconds::zero()) {
-            GenericReceiver<Converted>::condition.wait(lock);
-          } else {
-            if (GenericReceiver<Converted>::condition.wait_until(lock, timeout_point) == std::cv_status::timeout) {
-              throw TopicTimeoutException("Receiver topic timeout.", GenericReceiver<Converted>::node.getLogger());
-            }
-          }
-        }
+      if (policy == SyncPolicy::approximate && index != 0) {
+        const Clock::time_point previous = queue[index - 1].storage->getTimestamp();
 
-        if constexpr (can_move_from<MessageType>) {
-          Move<MessageType::moveTo>::call(std::move(message_buffer[index].message), result, user_ptr);
-        } else {
-          Convert<MessageType::convertTo>::call(message_buffer[index].message, result, user_ptr);
+        if (pivot - previous < timestamp - pivot) {
+          --index;
+          timestamp = previous;
         }
-        message_buffer[index].update_flag = false;
       }
 
-      mode = Mode::next;
-      GenericReceiver<Converted>::next_count = local_count;
-
-      return result;
+      return true;
     }
 
     /**
-     * @brief Register a callback function.
+     * @brief Remove the oldest messages of a topic without matching them.
      *
-     * @param function Callback function to be registered.
-     * @param policy Launch policy to control whether the callback will be launched in a new thread. If your callback is expected to only
-     * take up a short amount of time, change this to lbot::ExecutionPolicy::serial.
+     * @tparam I Index of the topic.
+     * @param count Number of messages to be removed.
      */
-    void setCallback(CallbackFunction::FunctionNoPtr function, ExecutionPolicy policy = ExecutionPolicy::serial)
+    template <std::size_t I>
+    void discard(std::size_t count)
     {
-      if (callback.valid()) {
-        throw BadUsageException("A callback has already been registered.");
-      }
+      auto &queue = std::get<I>(queues);
 
-      callback = function;
-      callback_ptr = nullptr;
-      callback_policy = (policy == ExecutionPolicy::parallel) ? std::launch::async : std::launch::deferred;
+      queue.erase(queue.begin(), queue.begin() + count);
+      dropped_count.fetch_add(count, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Register a callback function.
+     * @brief Convert the matched messages and invoke the callback.
+     * Messages are moved out of the receiver buffers where possible.
      *
-     * @param function Callback function to be registered.
-     * @param user_ptr User pointer to be supplied on callbacks.
-     * @param policy Launch policy to control whether the callback will be launched in a new thread. If your callback is expected take up
-     * considerable resources, change this to lbot::ExecutionPolicy::parallel.
+     * @param indices Indices of the matched messages within the queues.
      */
-    template <typename DataType>
-    void setCallback(
-      CallbackFunction::template Function<DataType> function,
-      DataType *user_ptr,
-      ExecutionPolicy policy = ExecutionPolicy::serial
-    )
+    void emit(const std::array<std::size_t, topic_count> &indices)
     {
-      if (callback.valid()) {
-        throw BadUsageException("A callback has already been registered.");
-      }
-
-      callback = function;
-      callback_ptr = reinterpret_cast<void *>(user_ptr);
-      callback_policy = (policy == ExecutionPolicy::parallel) ? std::launch::async : std::launch::deferred;
+      std::tuple<typename Receiver<MessageTypes>::Converted...> values;
+
+      forEach([&](auto index) {
+        auto &entry = std::get<index>(queues)[indices[index]];
+        std::get<index>(receivers)->extract(entry.count, entry.storage, std::get<index>(values));
+      });
+
+      std::apply(
+        [this](const auto &...value) -> void {
+          callback(value..., callback_ptr);
+        },
+        values
+      );
     }
 
-  private:
-    CallbackFunction callback;
-    void *callback_ptr;
-    std::launch callback_policy;
+    const std::chrono::nanoseconds tolerance;
+    const SyncPolicy policy;
+    const std::size_t queue_size;
 
-    enum class Mode : u8
-    {
-      latest,
-      next,
-    } mode = Mode::latest;
-  };
+    Function<void> callback = nullptr;
+    void *callback_ptr = nullptr;
+    std::atomic<bool> active;
 
-  // Wrapper classes to allow flatbuffer types to also work as template arguments.
-  template <typename MessageType>
-  class Receiver final : public ReceiverBase<MessageType>
-  {
-  public:
-    using Super = ReceiverBase<MessageType>;
-    using Ptr = std::unique_ptr<Receiver<MessageType>>;
+    std::atomic<bool> busy;
+    std::atomic<bool> pending;
 
-    template <typename... Args>
-    explicit Receiver(Args &&...args) :
-      Super(std::forward<Args>(args)...){};
-  };
+    std::atomic<u64> dropped_count;
 
-  template <typename FlatbufferType>
-  requires is_flatbuffer<FlatbufferType>
-  class Receiver<FlatbufferType> final : public ReceiverBase<Message<FlatbufferType>>
-  {
-  public:
-    using Super = ReceiverBase<Message<FlatbufferType>>;
-    using Ptr = std::unique_ptr<Receiver<FlatbufferType>>;
+    std::tuple<typename Receiver<MessageTypes>::Ptr...> receivers;
+    std::tuple<std::deque<Entry<typename Receiver<MessageTypes>::Storage>>...> queues;
 
-    template <typename... Args>
-    explicit Receiver(Args &&...args) :
-      Super(std::forward<Args>(args)...){};
+    // The listeners must be destroyed before the receivers.
+    std::tuple<std::unique_ptr<Listener<MessageTypes>>...> listeners;
   };
 
   template <typename RequestType, typename ResponseType>
@@ -1155,7 +3249,7 @@ public:
       ConsumerGuard<u32> guard(node.environment.plugin_use_count, node.environment.plugin_update_flag);
 
       for (Manager::PluginRegistration &plugin : node.environment.plugin_list) {
-        if (!plugin.filter.check(GenericServer<RequestConverted, ResponseConverted>::service_info.service_hash)) {
+        if (!plugin.filter.check(GenericServer<RequestConverted, ResponseConverted>::service_info.service_name)) {
           continue;
         }
 
@@ -1174,6 +3268,9 @@ public:
     HandlerFunction handler;
     void *handler_ptr;
 
+    std::unique_ptr<Executor> worker_executor;
+    Executor *executor = nullptr;
+
   public:
     /**
      * @brief Destroy the Server object.
@@ -1181,6 +3278,7 @@ public:
      */
     ~ServerBase()
     {
+      // Queued requests keep the server registered, so that they are handled by the server before it is removed.
       GenericServer<RequestConverted, ResponseConverted>::service_info.service.removeServer(this);
     }
 
@@ -1215,6 +3313,39 @@ public:
       handler = function;
       handler_ptr = reinterpret_cast<void *>(user_ptr);
     }
+
+    /**
+     * @brief Handle requests on a dedicated pool of worker threads.
+     * @details Requests made with lbot::ExecutionPolicy::parallel or lbot::ExecutionPolicy::pooled are queued and handled by the workers
+     * instead of a new thread per request. Requests made with lbot::ExecutionPolicy::serial are still handled by the calling thread.
+     *
+     * @param thread_count Number of worker threads. When zero, the number of concurrent threads supported by the system will be used.
+     */
+    void setWorkers(std::size_t thread_count = 0)
+    {
+      if (executor != nullptr) {
+        throw BadUsageException("An executor has already been registered.");
+      }
+
+      worker_executor = std::make_unique<Executor>(thread_count, "server");
+      executor = worker_executor.get();
+    }
+
+    /**
+     * @brief Handle requests on the supplied executor.
+     * @details Requests made with lbot::ExecutionPolicy::parallel or lbot::ExecutionPolicy::pooled are queued and handled by the executor
+     * instead of a new thread per request. Requests made with lbot::ExecutionPolicy::serial are still handled by the calling thread.
+     *
+     * @param executor Executor on which requests will be handled. The executor must outlive the server.
+     */
+    void setExecutor(Executor &executor)
+    {
+      if (this->executor != nullptr) {
+        throw BadUsageException("An executor has already been registered.");
+      }
+
+      this->executor = &executor;
+    }
   };
 
   // Wrapper classes to allow flatbuffer types to also work as template arguments.
@@ -1337,11 +3468,135 @@ public:
       user_ptr(user_ptr)
     {}
 
+    /**
+     * @brief Handle a request within the calling thread.
+     *
+     * @param request Object containing the data to be processed by the corresponding server.
+     * @return ResponseConverted Response from the server.
+     * @throw ServiceUnavailableException When no server is handling requests to the relevant service.
+     */
+    ResponseConverted handleRequest(RequestConverted &&request)
+    {
+      ServiceMap::Service::ServerReference reference = GenericClient<RequestConverted, ResponseConverted>::service_info.service.getServer();
+
+      return handleRequest(reference, std::move(request));
+    }
+
+    /**
+     * @brief Handle a request within the calling thread.
+     *
+     * @param server Server handling the request. It must be kept alive by a reference held by the caller.
+     * @param request Object containing the data to be processed by the corresponding server.
+     * @return ResponseConverted Response from the server.
+     * @throw ServiceUnavailableException When no server is handling requests to the relevant service.
+     */
+    ResponseConverted handleRequest(Server<RequestType, ResponseType> *server, RequestConverted &&request)
+    {
+      const Clock::time_point now = Clock::now();
+
+      if (server == nullptr) {
+        throw ServiceUnavailableException("Service is not available.", node.getLogger());
+      }
+      if (!server->handler.valid()) {
+        throw ServiceUnavailableException("Service has no registered handler.", node.getLogger());
+      }
+
+      RequestStorage request_storage(now);
+
+      if constexpr (can_move_from<RequestType>) {
+        Move<RequestType::moveFrom>::call(std::move(request), request_storage, user_ptr);
+      } else {
+        Convert<RequestType::convertFrom>::call(request, request_storage, user_ptr);
+      }
+
+      ResponseStorage response_storage = server->handler.call(request_storage, server->user_ptr, server->handler_ptr);
+
+      if constexpr (is_standard_message<ResponseStorage>) {
+        return response_storage;
+      } else {
+        ResponseConverted response;
+
+        if constexpr (can_move_to<ResponseType>) {
+          Move<ResponseType::moveTo>::call(std::move(response_storage), response, user_ptr);
+        } else {
+          Convert<ResponseType::convertTo>::call(response_storage, response, user_ptr);
+        }
+
+        return response;
+      }
+    }
+
+    /**
+     * @brief Request queued on an executor.
+     * Requests are recycled by the client, so that neither the request nor the shared state of its promise has to be allocated per call.
+     *
+     */
+    struct PendingRequest
+    {
+      PendingRequest(ClientBase &client, std::shared_ptr<std::atomic<std::size_t>> pending_count) :
+        client(client),
+        pending_count(std::move(pending_count))
+      {}
+
+      /**
+       * @brief Handle the request and complete its promise.
+       *
+       */
+      void run()
+      {
+        // The request is returned to the pool once this function returns.
+        const std::shared_ptr<PendingRequest> lease = std::move(self);
+
+        try {
+          ResponseConverted response = client.handleRequest(*reference, std::move(*request));
+
+          reference.reset();
+          promise->set_value(std::move(response));
+        } catch (...) {
+          reference.reset();
+          promise->set_exception(std::current_exception());
+        }
+
+        // Resume the awaiting coroutine, which will find the promise completed. The coroutine is not accessed if its scheduler has been
+        // destroyed in the meantime.
+        if (link != nullptr) {
+          std::exchange(link, nullptr)->schedule(std::exchange(continuation, nullptr));
+        }
+
+        // The client might be destroyed as soon as the count reaches zero. The count itself is shared with the pending requests.
+        pending_count->fetch_sub(1);
+        pending_count->notify_all();
+      }
+
+      ClientBase &client;
+      const std::shared_ptr<std::atomic<std::size_t>> pending_count;
+
+      std::optional<RequestConverted> request;
+      std::optional<std::promise<ResponseConverted>> promise;
+
+      // Keeps the server registered until the request has been handled, so that removing the server waits for the request.
+      std::optional<ServiceMap::Service::ServerReference> reference;
+
+      // Coroutine to be resumed once the request has been handled, if any.
+      std::shared_ptr<Scheduler::Link> link;
+      std::coroutine_handle<> continuation;
+
+      // Keeps the request alive while it is queued.
+      std::shared_ptr<PendingRequest> self;
+    };
+
     friend class Node;
 
     Node &node;
     void *const user_ptr;
 
+    static constexpr std::size_t request_pool_size = 16;
+    const std::shared_ptr<ObjectPool<PendingRequest>> request_pool = ObjectPool<PendingRequest>::create(request_pool_size);
+    const std::shared_ptr<BlockPool> promise_pool = BlockPool::create(request_pool_size);
+
+    // Number of requests queued on an executor, which must be completed before the client is destroyed.
+    const std::shared_ptr<std::atomic<std::size_t>> pending_count = std::make_shared<std::atomic<std::size_t>>(0);
+
   public:
     using Future = std::shared_future<ResponseConverted>;
 
@@ -1349,58 +3604,36 @@ public:
      * @brief Destroy the Client object.
      *
      */
-    ~ClientBase() = default;
+    ~ClientBase()
+    {
+      waitUntil<std::size_t>(*pending_count, 0);
+    }
 
     /**
      * @brief Make a request to a service asynchronously.
      * A call to this function will not block.
      *
      * @param request Object containing the data to be processed by the corresponding server.
-     * @param policy Launch policy to specify whether to launch a new thread.
+     * @param policy Launch policy to specify whether to launch a new thread. Unless the policy is lbot::ExecutionPolicy::serial, the
+     * request is queued on the workers of the server if it has any. Otherwise lbot::ExecutionPolicy::pooled queues it on the shared
+     * executor.
      * @return Future Future to be completed by the server.
      * @throw ServiceUnavailableException When no server is handling requests to the relevant service.
      */
     Future callAsync(const RequestConverted &request, ExecutionPolicy policy = ExecutionPolicy::parallel)
     {
-      const std::launch launch_policy = (policy == ExecutionPolicy::parallel) ? std::launch::async : std::launch::deferred;
-
-      return std::async(launch_policy, [this](RequestConverted request) -> ResponseConverted {
-        const Clock::time_point now = Clock::now();
-
-        ServiceMap::Service::ServerReference reference =
-          GenericClient<RequestConverted, ResponseConverted>::service_info.service.getServer();
-        Server<RequestType, ResponseType> *server = reference;
-
-        if (server == nullptr) {
-          throw ServiceUnavailableException("Service is not available.", node.getLogger());
-        }
-        if (!server->handler.valid()) {
-          throw ServiceUnavailableException("Service has no registered handler.", node.getLogger());
-        }
+      if (policy != ExecutionPolicy::serial) {
+        Future future;
 
-        RequestStorage request_storage(now);
-
-        if constexpr (can_move_from<RequestType>) {
-          Move<RequestType::moveFrom>::call(std::move(request), request_storage, user_ptr);
-        } else {
-          Convert<RequestType::convertFrom>::call(request, request_storage, user_ptr);
+        if (submitRequest(request, policy, future)) {
+          return future;
         }
+      }
 
-        ResponseStorage response_storage = server->handler.call(request_storage, server->user_ptr, server->handler_ptr);
-
-        if constexpr (is_standard_message<ResponseStorage>) {
-          return response_storage;
-        } else {
-          ResponseConverted response;
-
-          if constexpr (can_move_to<ResponseType>) {
-            Move<ResponseType::moveTo>::call(std::move(response_storage), response, user_ptr);
-          } else {
-            Convert<ResponseType::convertTo>::call(response_storage, response, user_ptr);
-          }
+      const std::launch launch_policy = (policy == ExecutionPolicy::serial) ? std::launch::deferred : std::launch::async;
 
-          return response;
-        }
+      return std::async(launch_policy, [this](RequestConverted request) -> ResponseConverted {
+        return handleRequest(std::move(request));
       }, request);
     }
 
@@ -1445,6 +3678,122 @@ public:
     {
       return callSync(request, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
     }
+
+    /**
+     * @brief Make a request to a service from within a coroutine.
+     * The request is queued like a call to callAsync() with lbot::ExecutionPolicy::pooled. The coroutine is suspended without blocking its
+     * thread until the request has been handled.
+     *
+     * @param request Object containing the data to be processed by the corresponding server.
+     * @return Task<ResponseConverted> Task yielding the response from the server.
+     * @throw ServiceUnavailableException When no server is handling requests to the relevant service.
+     * @throw BadUsageException When the calling coroutine is not run by a Scheduler.
+     */
+    Task<ResponseConverted> call(RequestConverted request)
+    {
+      co_return co_await CallAwaiter(*this, std::move(request));
+    }
+
+  private:
+    /**
+     * @brief Awaitable to suspend a coroutine until a request has been handled by the server.
+     *
+     */
+    class CallAwaiter
+    {
+    public:
+      CallAwaiter(ClientBase &client, RequestConverted &&request) :
+        client(client),
+        request(std::move(request))
+      {}
+
+      CallAwaiter(const CallAwaiter &) = delete;
+
+      [[nodiscard]] bool await_ready() const
+      {
+        return false;
+      }
+
+      bool await_suspend(std::coroutine_handle<> handle)
+      {
+        Scheduler *scheduler = Scheduler::current();
+
+        if (scheduler == nullptr) {
+          throw BadUsageException("Clients can only be awaited from within a scheduler.", client.node.getLogger());
+        }
+
+        // The awaiter might be resumed and destroyed by another thread as soon as the request has been submitted.
+        return client.submitRequest(request, ExecutionPolicy::pooled, future, scheduler->getLink(), handle);
+      }
+
+      ResponseConverted await_resume()
+      {
+        return future.get();
+      }
+
+    private:
+      ClientBase &client;
+      const RequestConverted request;
+      Future future;
+    };
+
+    /**
+     * @brief Queue a request on the workers of the server or on the shared executor.
+     * The future is assigned before the request is queued.
+     *
+     * @param request Object containing the data to be processed by the corresponding server.
+     * @param policy Execution policy of the request. It must not be lbot::ExecutionPolicy::serial.
+     * @param future Future to be completed by the server.
+     * @param link Link to the scheduler to resume the continuation on once the request has been handled.
+     * @param continuation Coroutine to be resumed once the request has been handled.
+     * @return true When the request has been queued.
+     * @return false When no executor is available for the policy.
+     */
+    bool submitRequest(
+      const RequestConverted &request,
+      ExecutionPolicy policy,
+      Future &future,
+      std::shared_ptr<Scheduler::Link> link = nullptr,
+      std::coroutine_handle<> continuation = nullptr
+    )
+    {
+      // The reference prevents the server and its executor from being destroyed while the request is submitted.
+      ServiceMap::Service::ServerReference reference = GenericClient<RequestConverted, ResponseConverted>::service_info.service.getServer();
+      Server<RequestType, ResponseType> *server = reference;
+
+      Executor *executor = (server != nullptr) ? server->executor : nullptr;
+
+      if (executor == nullptr && policy == ExecutionPolicy::pooled) {
+        executor = &Manager::get()->getExecutor();
+      }
+
+      if (executor == nullptr) {
+        return false;
+      }
+
+      std::shared_ptr<PendingRequest> pending = request_pool->acquire(*this, pending_count);
+
+      // Recycled requests keep the buffers of their previous request.
+      pending->request = request;
+      pending->promise.emplace(std::allocator_arg, PoolAllocator<ResponseConverted>(promise_pool));
+      pending->reference.emplace(std::move(reference));
+      pending->link = std::move(link);
+      pending->continuation = continuation;
+
+      future = pending->promise->get_future().share();
+
+      pending_count->fetch_add(1);
+
+      // Only a raw pointer is captured, so that the task fits into the small buffer of std::function.
+      PendingRequest *const pointer = pending.get();
+      pointer->self = std::move(pending);
+
+      executor->submit([pointer]() -> void {
+        pointer->run();
+      });
+
+      return true;
+    }
   };
 
   // Wrapper classes to allow flatbuffer types to also work as template arguments.
@@ -1575,6 +3924,41 @@ protected:
     return Ptr(new Receiver<MessageType>(topic_name, *this, std::forward<Args>(args)...));
   }
 
+  /**
+   * @brief Construct and add a view receiver to the node.
+   * View receivers access the serialized message directly and thus never unpack it.
+   *
+   * @tparam FlatbufferType Type of the flatbuffer table sent over the topic.
+   * @tparam Args Types of the arguments to be forwarded to the receiver specific constructor.
+   * @param args Arguments to be forwarded to the receiver specific constructor.
+   * @return ViewReceiver<FlatbufferType>::Ptr Pointer to the receiver.
+   */
+  template <typename FlatbufferType, typename... Args>
+  typename ViewReceiver<FlatbufferType>::Ptr addViewReceiver(const std::string &topic_name, Args &&...args)
+  requires is_flatbuffer<FlatbufferType>
+  {
+    using Ptr = ViewReceiver<FlatbufferType>::Ptr;
+    return Ptr(new ViewReceiver<FlatbufferType>(topic_name, *this, std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Construct and add a synchronizer to the node.
+   * The synchronizer creates its own receivers for the supplied topics.
+   *
+   * @tparam MessageTypes Types of the messages sent over the topics.
+   * @tparam Args Types of the arguments to be forwarded to the synchronizer specific constructor.
+   * @param topic_names Names of the topics in the order of the message types.
+   * @param args Arguments to be forwarded to the synchronizer specific constructor.
+   * @return Synchronizer<MessageTypes...>::Ptr Pointer to the synchronizer.
+   */
+  template <typename... MessageTypes, typename... Args>
+  typename Synchronizer<MessageTypes...>::Ptr
+  addSynchronizer(const std::array<std::string, sizeof...(MessageTypes)> &topic_names, Args &&...args)
+  {
+    using Ptr = Synchronizer<MessageTypes...>::Ptr;
+    return Ptr(new Synchronizer<MessageTypes...>(topic_names, *this, std::forward<Args>(args)...));
+  }
+
   /**
    * @brief Construct and add a server to the node.
    *
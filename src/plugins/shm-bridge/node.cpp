@@ -0,0 +1,672 @@
+/**
+ * @file node.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/message.hpp>
+#include <labrat/lbot/node.hpp>
+#include <labrat/lbot/plugins/shm-bridge/node.hpp>
+#include <labrat/lbot/utils/thread.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+inline namespace labrat {
+namespace lbot::plugins {
+
+class ShmBridge::NodePrivate
+{
+public:
+  struct BridgeSender
+  {
+    struct Entry
+    {
+      Node::GenericSender<ShmBridge::Node::PayloadInfo>::Ptr sender;
+      ShmBridge::Node::PayloadVerifier verifier;
+    };
+
+    std::unordered_map<std::string, Entry> map;
+    std::unordered_map<std::size_t, Entry &> adapter;
+  } sender;
+
+  struct BridgeReceiver
+  {
+    std::vector<std::unique_ptr<ShmBridge::Node::ReceiverAdapter>> vector;
+    std::mutex mutex;
+  } receiver;
+
+  NodePrivate(const std::string &local_name, const std::string &remote_name, std::size_t capacity, ShmBridge::Node &node);
+  ~NodePrivate();
+
+  void registerReceiverAdapter(std::unique_ptr<ShmBridge::Node::ReceiverAdapter> &&adapter);
+
+  void writePayloadMessage(const ShmBridge::Node::PayloadInfo &message);
+
+private:
+  static constexpr std::size_t cache_line_size = 64;
+  static constexpr std::size_t record_alignment = 16;
+
+  struct TopicInfo
+  {
+    std::size_t topic_hash;
+    std::string_view topic_name;
+    std::string_view type_name;
+  };
+
+  /**
+   * @brief Control block at the start of each shared memory ring.
+   * The offsets increase monotonically, the position within the ring is obtained by taking them modulo the capacity. The write side
+   * and the read side of the ring are placed on separate cache lines.
+   *
+   */
+  struct RingHeader
+  {
+    std::atomic<u32> ready;
+
+    u8 magic;
+    u8 version_major;
+    u8 version_minor;
+
+    u64 capacity;
+
+    alignas(cache_line_size) std::atomic<u64> write_offset;
+    std::atomic<u32> write_sequence;
+
+    alignas(cache_line_size) std::atomic<u64> read_offset;
+    std::atomic<u32> reader_waiting;
+
+    static constexpr u8 magic_check = 0x6a;
+    static constexpr u8 version_major_check = GIT_VERSION_MAJOR;
+    static constexpr u8 version_minor_check = GIT_VERSION_MINOR;
+  };
+
+  static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free);
+  static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "The futex word must be a plain 32 bit integer.");
+
+  static constexpr std::size_t header_size = (sizeof(RingHeader) + cache_line_size - 1) & ~(cache_line_size - 1);
+
+  struct RecordHeader
+  {
+    u32 length;
+
+    enum class Type : u8
+    {
+      payload = 0,
+      topic_info = 1,
+      topic_request = 2,
+      padding = 3,
+    } type;
+
+    u8 flags;
+    u16 topic_name_end;
+
+    u64 topic_hash;
+  };
+
+  static_assert(sizeof(RecordHeader) == record_alignment);
+
+  struct Ring
+  {
+    std::string name;
+    std::size_t size = 0;
+
+    RingHeader *header = nullptr;
+    u8 *data = nullptr;
+
+    int file_descriptor = -1;
+  };
+
+  static inline std::size_t recordSize(std::size_t length)
+  {
+    return (sizeof(RecordHeader) + length + record_alignment - 1) & ~(record_alignment - 1);
+  }
+
+  void readLoop();
+  bool mapRemote();
+  void unmapRemote();
+  void waitRemote(u64 read_offset);
+
+  void readPayloadMessage(const ShmBridge::Node::PayloadInfo &message);
+  void readTopicInfoMessage(const TopicInfo &message);
+  void readTopicRequestMessage(std::size_t topic_hash);
+
+  void writeTopicInfoMessage(const TopicInfo &message);
+  void writeTopicRequestMessage(std::size_t topic_hash);
+
+  void writeLoop();
+
+  /**
+   * @brief Write a record into the local ring and wake up the peer if it is waiting.
+   *
+   * @param record Header of the record. The length must be set to the sum of the sizes of the parts.
+   * @param parts Contents of the record.
+   * @return true When the record has been written.
+   * @return false When the ring does not have enough room left.
+   */
+  bool write(const RecordHeader &record, std::initializer_list<std::span<const u8>> parts);
+
+  ShmBridge::Node &node;
+
+  Ring local;
+  Ring remote;
+
+  static constexpr i32 timeout = 100;
+
+  std::mutex mutex;
+
+  WaitSet wait_set;
+
+  // Only accessed by the write thread, so that its allocation is reused across wake ups.
+  std::vector<Waitable *> ready;
+
+  LoopThread read_thread;
+  LoopThread write_thread;
+};
+
+ShmBridge::ShmBridge(const std::string &local_name, const std::string &remote_name, std::size_t capacity) :
+  Plugin()
+{
+  node = addNode<ShmBridge::Node>(getName(), local_name, remote_name, capacity);
+}
+
+ShmBridge::~ShmBridge() = default;
+
+ShmBridge::Node::Node(const std::string &local_name, const std::string &remote_name, std::size_t capacity) :
+  lbot::Node()
+{
+  priv = new ShmBridge::NodePrivate(local_name, remote_name, capacity, *this);
+}
+
+ShmBridge::Node::~Node()
+{
+  delete priv;
+}
+
+void ShmBridge::Node::registerGenericSender(Node::GenericSender<ShmBridge::Node::PayloadInfo>::Ptr &&sender, PayloadVerifier verifier)
+{
+  const std::string topic_name = sender->getTopicInfo().topic_name;
+
+  NodePrivate::BridgeSender::Entry entry{
+    .sender = std::forward<Node::GenericSender<ShmBridge::Node::PayloadInfo>::Ptr>(sender),
+    .verifier = verifier,
+  };
+
+  if (!priv->sender.map.try_emplace(topic_name, std::move(entry)).second) {
+    throw ManagementException("A sender has already been registered for the topic name '" + topic_name + "'.");
+  }
+}
+
+void ShmBridge::Node::registerReceiverAdapter(std::unique_ptr<ReceiverAdapter> &&adapter)
+{
+  priv->registerReceiverAdapter(std::forward<std::unique_ptr<ReceiverAdapter>>(adapter));
+}
+
+void ShmBridge::Node::writePayload(const PayloadInfo &message)
+{
+  priv->writePayloadMessage(message);
+}
+
+ShmBridge::NodePrivate::NodePrivate(
+  const std::string &local_name, const std::string &remote_name, std::size_t capacity, ShmBridge::Node &node
+) :
+  node(node)
+{
+  if (local_name == remote_name) {
+    throw InvalidArgumentException("The local and remote ring names must differ.");
+  }
+
+  const std::size_t page_size = sysconf(_SC_PAGESIZE);
+  capacity = (capacity + page_size - 1) / page_size * page_size;
+
+  if (capacity == 0) {
+    throw InvalidArgumentException("The ring capacity must not be zero.");
+  }
+
+  local.name = "/lbot-" + local_name;
+  local.size = header_size + capacity;
+  remote.name = "/lbot-" + remote_name;
+
+  // Remove a ring left behind by a previous run.
+  shm_unlink(local.name.c_str());
+
+  const int file_descriptor = shm_open(local.name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+
+  if (file_descriptor == -1) {
+    throw IoException("Failed to create shared memory ring.", errno);
+  }
+
+  if (ftruncate(file_descriptor, local.size) == -1) {
+    close(file_descriptor);
+    shm_unlink(local.name.c_str());
+    throw IoException("Failed to resize shared memory ring.", errno);
+  }
+
+  void *address = mmap(nullptr, local.size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  close(file_descriptor);
+
+  if (address == MAP_FAILED) {
+    shm_unlink(local.name.c_str());
+    throw IoException("Failed to map shared memory ring.", errno);
+  }
+
+  local.header = new (address) RingHeader();
+  local.data = reinterpret_cast<u8 *>(address) + header_size;
+
+  local.header->magic = RingHeader::magic_check;
+  local.header->version_major = RingHeader::version_major_check;
+  local.header->version_minor = RingHeader::version_minor_check;
+  local.header->capacity = capacity;
+
+  // The peer only accesses the ring once it has been marked as ready.
+  local.header->ready.store(1, std::memory_order_release);
+
+  read_thread = LoopThread(&ShmBridge::NodePrivate::readLoop, "shm bridge", 1, this);
+  write_thread = LoopThread(&ShmBridge::NodePrivate::writeLoop, "shm bridge", 1, this);
+}
+
+ShmBridge::NodePrivate::~NodePrivate()
+{
+  read_thread.stop();
+  write_thread.stop();
+
+  unmapRemote();
+
+  munmap(local.header, local.size);
+  shm_unlink(local.name.c_str());
+}
+
+void ShmBridge::NodePrivate::registerReceiverAdapter(std::unique_ptr<ShmBridge::Node::ReceiverAdapter> &&adapter)
+{
+  std::lock_guard guard(receiver.mutex);
+
+  wait_set.attach(adapter->getWaitable());
+  receiver.vector.emplace_back(std::forward<std::unique_ptr<ShmBridge::Node::ReceiverAdapter>>(adapter));
+}
+
+void ShmBridge::NodePrivate::readLoop()
+{
+  if (remote.header == nullptr && !mapRemote()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+    return;
+  }
+
+  const u64 capacity = remote.header->capacity;
+  u64 read_offset = remote.header->read_offset.load(std::memory_order_relaxed);
+  const u64 write_offset = remote.header->write_offset.load(std::memory_order_acquire);
+
+  if (read_offset == write_offset) {
+    waitRemote(read_offset);
+    return;
+  }
+
+  while (read_offset != write_offset) {
+    const std::size_t position = read_offset % capacity;
+
+    // The header is copied out of the shared memory, so that the peer cannot change it after it has been validated.
+    const RecordHeader record = *reinterpret_cast<const RecordHeader *>(remote.data + position);
+    const std::size_t size = recordSize(record.length);
+
+    if (size > capacity - position || size > write_offset - read_offset ||
+        (record.type == RecordHeader::Type::topic_info && record.topic_name_end > record.length)) {
+      node.getLogger().logError() << "Received corrupted record, discarding remaining contents of the ring.";
+      remote.header->read_offset.store(write_offset, std::memory_order_release);
+      return;
+    }
+
+    const u8 *payload = remote.data + position + sizeof(RecordHeader);
+
+    switch (record.type) {
+      case (RecordHeader::Type::payload): {
+        // The message is unpacked directly from the shared memory, so the record may only be released afterwards.
+        readPayloadMessage({.topic_hash = record.topic_hash, .payload = std::span<const u8>(payload, record.length)});
+
+        break;
+      }
+
+      case (RecordHeader::Type::topic_info): {
+        TopicInfo message;
+        message.topic_hash = record.topic_hash;
+        message.topic_name = std::string_view(reinterpret_cast<const char *>(payload), record.topic_name_end);
+        message.type_name =
+          std::string_view(reinterpret_cast<const char *>(payload) + record.topic_name_end, record.length - record.topic_name_end);
+
+        readTopicInfoMessage(message);
+
+        break;
+      }
+
+      case (RecordHeader::Type::topic_request): {
+        readTopicRequestMessage(record.topic_hash);
+
+        break;
+      }
+
+      case (RecordHeader::Type::padding): {
+        break;
+      }
+
+      default: {
+        node.getLogger().logError() << "Received unknown record type.";
+      }
+    }
+
+    read_offset += size;
+    remote.header->read_offset.store(read_offset, std::memory_order_release);
+  }
+}
+
+bool ShmBridge::NodePrivate::mapRemote()
+{
+  const int file_descriptor = shm_open(remote.name.c_str(), O_RDWR, 0);
+
+  if (file_descriptor == -1) {
+    if (errno == ENOENT) {
+      return false;
+    }
+
+    throw IoException("Failed to open shared memory ring.", errno);
+  }
+
+  struct stat status;
+
+  // The peer might not have resized the ring yet.
+  if (fstat(file_descriptor, &status) == -1 || static_cast<std::size_t>(status.st_size) <= header_size) {
+    close(file_descriptor);
+    return false;
+  }
+
+  const std::size_t size = status.st_size;
+  void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+
+  if (address == MAP_FAILED) {
+    close(file_descriptor);
+    throw IoException("Failed to map shared memory ring.", errno);
+  }
+
+  RingHeader *header = reinterpret_cast<RingHeader *>(address);
+
+  remote.size = size;
+  remote.header = header;
+  remote.file_descriptor = file_descriptor;
+
+  if (header->ready.load(std::memory_order_acquire) == 0) {
+    unmapRemote();
+    return false;
+  }
+
+  if (header->magic != RingHeader::magic_check) {
+    node.getLogger().logError() << "Remote ring has wrong magic byte.";
+    unmapRemote();
+    return false;
+  }
+  if (header->version_major != RingHeader::version_major_check) {
+    node.getLogger().logError() << "Remote ring has different major version number.";
+    unmapRemote();
+    return false;
+  }
+  if (header->version_minor != RingHeader::version_minor_check) {
+    node.getLogger().logWarning() << "Remote ring has different minor version number.";
+  }
+  if (header->capacity != size - header_size) {
+    node.getLogger().logError() << "Remote ring size and capacity mismatch.";
+    unmapRemote();
+    return false;
+  }
+
+
+  remote.data = reinterpret_cast<u8 *>(address) + header_size;
+
+  return true;
+}
+
+void ShmBridge::NodePrivate::unmapRemote()
+{
+  if (remote.header != nullptr) {
+    munmap(remote.header, remote.size);
+    close(remote.file_descriptor);
+  }
+
+  remote.header = nullptr;
+  remote.data = nullptr;
+  remote.file_descriptor = -1;
+}
+
+void ShmBridge::NodePrivate::waitRemote(u64 read_offset)
+{
+  const u32 sequence = remote.header->write_sequence.load(std::memory_order_acquire);
+
+  // Announce the waiter before checking the ring again, so that the writer either sees the flag or the reader sees the new record.
+  remote.header->reader_waiting.store(1, std::memory_order_seq_cst);
+
+  if (remote.header->write_offset.load(std::memory_order_seq_cst) == read_offset) {
+    const timespec timeout_spec = {.tv_sec = 0, .tv_nsec = timeout * 1000000L};
+
+    const long result =
+      syscall(SYS_futex, reinterpret_cast<u32 *>(&remote.header->write_sequence), FUTEX_WAIT, sequence, &timeout_spec, nullptr, 0);
+
+    if (result == -1 && errno == ETIMEDOUT) {
+      remote.header->reader_waiting.store(0, std::memory_order_relaxed);
+
+      // A peer that has been restarted creates a new ring, the old one is only kept alive by this mapping.
+      struct stat status;
+
+      if (fstat(remote.file_descriptor, &status) == 0 && status.st_nlink == 0) {
+        node.getLogger().logInfo() << "Remote ring has been removed, waiting for the peer to reconnect.";
+        unmapRemote();
+      }
+
+      return;
+    }
+  }
+
+  remote.header->reader_waiting.store(0, std::memory_order_relaxed);
+}
+
+void ShmBridge::NodePrivate::readPayloadMessage(const ShmBridge::Node::PayloadInfo &message)
+{
+  auto iterator = sender.adapter.find(message.topic_hash);
+
+  if (iterator == sender.adapter.end()) {
+    node.getLogger().logDebug() << "Received bridge message without adapter entry (remote topic hash: " << message.topic_hash << ").";
+    writeTopicRequestMessage(message.topic_hash);
+
+    return;
+  }
+
+  if (!iterator->second.verifier(message.payload)) {
+    node.getLogger().logError() << "Received invalid payload, discarding message (topic name: "
+                                << iterator->second.sender->getTopicInfo().topic_name << ").";
+    return;
+  }
+
+  iterator->second.sender->put(message);
+}
+
+void ShmBridge::NodePrivate::readTopicInfoMessage(const TopicInfo &message)
+{
+  auto iterator = sender.map.find(std::string(message.topic_name));
+
+  if (iterator == sender.map.end()) {
+    node.getLogger().logWarning() << "No registered handling implementation found (topic name: " << message.topic_name << ").";
+    return;
+  }
+
+  if (iterator->second.sender->getTopicInfo().type_name != message.type_name) {
+    node.getLogger().logWarning() << "Local and remote type names do not match (" << iterator->second.sender->getTopicInfo().type_name
+                                  << "/" << message.type_name << ").";
+    return;
+  }
+
+  sender.adapter.try_emplace(message.topic_hash, iterator->second);
+}
+
+void ShmBridge::NodePrivate::readTopicRequestMessage(std::size_t topic_hash)
+{
+  std::lock_guard guard(receiver.mutex);
+
+  for (const std::unique_ptr<ShmBridge::Node::ReceiverAdapter> &adapter : receiver.vector) {
+    if (adapter->getTopicInfo().topic_hash == topic_hash) {
+      TopicInfo message;
+      message.topic_hash = adapter->getTopicInfo().topic_hash;
+      message.topic_name = adapter->getTopicInfo().topic_name;
+      message.type_name = adapter->getTopicInfo().type_name;
+
+      writeTopicInfoMessage(message);
+      return;
+    }
+  }
+
+  node.getLogger().logDebug() << "Requested topic hash receiver not found (topic hash: " << topic_hash << ").";
+}
+
+void ShmBridge::NodePrivate::writeLoop()
+{
+  wait_set.wait(ready, std::chrono::milliseconds(timeout));
+
+  std::lock_guard guard(receiver.mutex);
+
+  for (Waitable *object : ready) {
+    for (const std::unique_ptr<ShmBridge::Node::ReceiverAdapter> &adapter : receiver.vector) {
+      if (&adapter->getWaitable() == object) {
+        adapter->drain(node);
+        break;
+      }
+    }
+  }
+}
+
+void ShmBridge::NodePrivate::writePayloadMessage(const ShmBridge::Node::PayloadInfo &message)
+{
+  RecordHeader record;
+  record.length = message.payload.size();
+  record.type = RecordHeader::Type::payload;
+  record.flags = 0;
+  record.topic_name_end = 0;
+  record.topic_hash = message.topic_hash;
+
+  if (recordSize(message.payload.size()) > local.header->capacity / 2) {
+    node.getLogger().logError() << "Maximum payload size exceeded.";
+    return;
+  }
+
+  if (!write(record, {message.payload})) {
+    node.getLogger().logWarning() << "Shared memory ring is full, discarding message.";
+  }
+}
+
+void ShmBridge::NodePrivate::writeTopicInfoMessage(const TopicInfo &message)
+{
+  if (message.topic_name.empty()) {
+    node.getLogger().logError() << "The sent topic name must not be empty.";
+    return;
+  }
+  if (message.type_name.empty()) {
+    node.getLogger().logError() << "The sent type name must not be empty.";
+    return;
+  }
+
+  RecordHeader record;
+  record.length = message.topic_name.size() + message.type_name.size();
+  record.type = RecordHeader::Type::topic_info;
+  record.flags = 0;
+  record.topic_name_end = message.topic_name.size();
+  record.topic_hash = message.topic_hash;
+
+  if (recordSize(record.length) > local.header->capacity / 2 || message.topic_name.size() > std::numeric_limits<u16>::max()) {
+    node.getLogger().logError() << "Maximum payload size exceeded.";
+    return;
+  }
+
+  write(
+    record,
+    {std::span<const u8>(reinterpret_cast<const u8 *>(message.topic_name.data()), message.topic_name.size()),
+     std::span<const u8>(reinterpret_cast<const u8 *>(message.type_name.data()), message.type_name.size())}
+  );
+}
+
+void ShmBridge::NodePrivate::writeTopicRequestMessage(std::size_t topic_hash)
+{
+  RecordHeader record;
+  record.length = 0;
+  record.type = RecordHeader::Type::topic_request;
+  record.flags = 0;
+  record.topic_name_end = 0;
+  record.topic_hash = topic_hash;
+
+  write(record, {});
+}
+
+bool ShmBridge::NodePrivate::write(const RecordHeader &record, std::initializer_list<std::span<const u8>> parts)
+{
+  const u64 capacity = local.header->capacity;
+  const std::size_t size = recordSize(record.length);
+
+  std::lock_guard guard(mutex);
+
+  u64 write_offset = local.header->write_offset.load(std::memory_order_relaxed);
+  const u64 read_offset = local.header->read_offset.load(std::memory_order_acquire);
+
+  std::size_t position = write_offset % capacity;
+  const std::size_t tail = capacity - position;
+
+  // Records are never split, so the remainder of the ring is skipped when the record does not fit.
+  const std::size_t required = (tail < size) ? size + tail : size;
+
+  if (capacity - (write_offset - read_offset) < required) {
+    return false;
+  }
+
+  if (tail < size) {
+    RecordHeader padding;
+    padding.length = tail - sizeof(RecordHeader);
+    padding.type = RecordHeader::Type::padding;
+    padding.flags = 0;
+    padding.topic_name_end = 0;
+    padding.topic_hash = 0;
+
+    std::memcpy(local.data + position, &padding, sizeof(RecordHeader));
+
+    write_offset += tail;
+    position = 0;
+  }
+
+  std::memcpy(local.data + position, &record, sizeof(RecordHeader));
+  position += sizeof(RecordHeader);
+
+  for (const std::span<const u8> &part : parts) {
+    std::memcpy(local.data + position, part.data(), part.size());
+    position += part.size();
+  }
+
+  local.header->write_offset.store(write_offset + size, std::memory_order_seq_cst);
+  local.header->write_sequence.fetch_add(1, std::memory_order_release);
+
+  // Only enter the kernel when the reader is actually waiting.
+  if (local.header->reader_waiting.load(std::memory_order_seq_cst) != 0) {
+    syscall(SYS_futex, reinterpret_cast<u32 *>(&local.header->write_sequence), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+  }
+
+  return true;
+}
+
+}  // namespace lbot::plugins
+}  // namespace labrat
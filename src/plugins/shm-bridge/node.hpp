@@ -0,0 +1,238 @@
+/**
+ * @file node.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/exception.hpp>
+#include <labrat/lbot/message.hpp>
+#include <labrat/lbot/node.hpp>
+#include <labrat/lbot/plugin.hpp>
+#include <labrat/lbot/waitset.hpp>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot::plugins {
+
+/**
+ * @brief Bridge to another labrat robot system on the same host.
+ * @details Messages are exchanged through two ring buffers in shared memory, one per direction. Each bridge creates the ring it writes to
+ * and maps the ring of its peer once it becomes available. Serialized messages are copied into the ring once and unpacked directly from the
+ * shared memory on the remote side.
+ *
+ */
+class ShmBridge final : public Plugin
+{
+public:
+  /**
+   * @brief Construct a new Shm Bridge object.
+   *
+   * @param local_name Name of the shared memory ring written by this bridge.
+   * @param remote_name Name of the shared memory ring written by the peer bridge.
+   * @param capacity Size of the shared memory ring in bytes. It will be rounded up to the page size.
+   */
+  ShmBridge(const std::string &local_name, const std::string &remote_name, std::size_t capacity = 0x1000000);
+  ~ShmBridge();
+
+  /**
+   * @brief Register a sender with the bridge. Incoming messages will be forwarded onto the sender.
+   *
+   * @tparam MessageType Message type of the sender.
+   * @param topic_name Name of the topic.
+   */
+  template <typename MessageType>
+  void registerSender(const std::string topic_name)
+  {
+    node->registerSender<MessageType>(topic_name);
+  }
+
+  /**
+   * @brief Register a receiver with the bridge. Incoming messages will be forwarded onto the shared memory ring.
+   *
+   * @tparam MessageType Message type of the receiver.
+   * @param topic_name Name of the topic.
+   */
+  template <typename MessageType>
+  void registerReceiver(const std::string topic_name)
+  {
+    node->registerReceiver<MessageType>(topic_name);
+  }
+
+private:
+  class NodePrivate;
+
+  /**
+   * @brief Node to connect itself to another labrat robot system on the same host.
+   * It will forward to and receive from the peer system.
+   *
+   */
+  class Node final : public lbot::Node
+  {
+  public:
+    struct PayloadInfo
+    {
+      std::size_t topic_hash;
+      std::span<const u8> payload;
+    };
+
+    using PayloadVerifier = bool (*)(std::span<const u8> payload);
+
+    template <typename T>
+    requires is_flatbuffer<T>
+    struct PayloadMessage : public MessageBase<T, PayloadInfo>
+    {
+      /**
+       * @brief Check whether a payload received from the peer is a valid flatbuffer of the message type.
+       * Payloads must be verified before being converted, as the peer memory cannot be trusted.
+       *
+       * @param payload Serialized payload.
+       * @return true When the payload can be safely unpacked.
+       */
+      static bool verify(std::span<const u8> payload)
+      {
+        flatbuffers::Verifier verifier(payload.data(), payload.size());
+
+        return verifier.VerifyBuffer<T>(nullptr);
+      }
+
+      static void convertFrom(const PayloadInfo &source, MessageBase<T, PayloadInfo> &destination)
+      {
+        flatbuffers::GetRoot<T>(source.payload.data())->UnPackTo(&destination);
+      }
+    };
+
+    /**
+     * @brief Type erased receiver to be drained by the write thread of the bridge.
+     *
+     */
+    class ReceiverAdapter
+    {
+    public:
+      virtual ~ReceiverAdapter() = default;
+
+      /**
+       * @brief Forward all unread messages of the receiver onto the shared memory ring.
+       *
+       * @param node Bridge node to write the messages with.
+       */
+      virtual void drain(Node &node) = 0;
+
+      [[nodiscard]] virtual Waitable &getWaitable() = 0;
+      [[nodiscard]] virtual const TopicInfo &getTopicInfo() const = 0;
+    };
+
+    /**
+     * @brief Construct a new Shm Bridge Node object.
+     *
+     * @param local_name Name of the shared memory ring written by this node.
+     * @param remote_name Name of the shared memory ring written by the peer node.
+     * @param capacity Size of the shared memory ring in bytes.
+     */
+    Node(const std::string &local_name, const std::string &remote_name, std::size_t capacity);
+    ~Node();
+
+    /**
+     * @brief Register a sender with the bridge node. Incoming messages will be forwarded onto the sender.
+     *
+     * @tparam MessageType Message type of the sender.
+     * @param topic_name Name of the topic.
+     */
+    template <typename MessageType>
+    void registerSender(const std::string topic_name)
+    {
+      registerGenericSender(addSender<PayloadMessage<MessageType>>(topic_name), &PayloadMessage<MessageType>::verify);
+    }
+
+    /**
+     * @brief Register a receiver with the bridge node. Incoming messages will be forwarded onto the shared memory ring.
+     * Messages are received as serialized views, so that they only have to be copied into the ring.
+     *
+     * @tparam FlatbufferType Message type of the receiver.
+     * @param topic_name Name of the topic.
+     */
+    template <typename FlatbufferType>
+    requires is_flatbuffer<FlatbufferType>
+    void registerReceiver(const std::string topic_name)
+    {
+      registerReceiverAdapter(std::make_unique<TypedReceiverAdapter<FlatbufferType>>(
+        addViewReceiver<FlatbufferType>(topic_name, receiver_buffer_size, QueuePolicy::overwrite_oldest)
+      ));
+    }
+
+  private:
+    template <typename FlatbufferType>
+    requires is_flatbuffer<FlatbufferType>
+    class TypedReceiverAdapter final : public ReceiverAdapter
+    {
+    public:
+      explicit TypedReceiverAdapter(typename ViewReceiver<FlatbufferType>::Ptr &&receiver) :
+        receiver(std::move(receiver))
+      {}
+
+      void drain(Node &node) override
+      {
+        if (!receiver->hasUnread()) {
+          return;
+        }
+
+        try {
+          receiver->drainInto(std::back_inserter(views));
+        } catch (TopicNoDataAvailableException &) {
+          // Only reached when the topic is flushed right after the check above.
+          return;
+        }
+
+        for (const MessageView<FlatbufferType> &view : views) {
+          node.writePayload(PayloadInfo{.topic_hash = receiver->getTopicInfo().topic_hash, .payload = view.getBuffer()});
+        }
+
+        // Release the views right away but keep the allocation for the next wake up.
+        views.clear();
+      }
+
+      [[nodiscard]] Waitable &getWaitable() override
+      {
+        return *receiver;
+      }
+
+      [[nodiscard]] const TopicInfo &getTopicInfo() const override
+      {
+        return receiver->getTopicInfo();
+      }
+
+    private:
+      const typename ViewReceiver<FlatbufferType>::Ptr receiver;
+
+      // Only accessed by the write thread.
+      std::vector<MessageView<FlatbufferType>> views;
+    };
+
+    static constexpr std::size_t receiver_buffer_size = 64;
+
+    void registerGenericSender(Node::GenericSender<PayloadInfo>::Ptr &&sender, PayloadVerifier verifier);
+    void registerReceiverAdapter(std::unique_ptr<ReceiverAdapter> &&adapter);
+
+    void writePayload(const PayloadInfo &message);
+
+    NodePrivate *priv;
+
+    friend NodePrivate;
+  };
+
+  std::shared_ptr<Node> node;
+};
+
+}  // namespace lbot::plugins
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -0,0 +1,215 @@
+/**
+ * @file statistics.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/config.hpp>
+#include <labrat/lbot/manager.hpp>
+#include <labrat/lbot/message.hpp>
+#include <labrat/lbot/msg/latency_statistics.hpp>
+#include <labrat/lbot/msg/topic_statistics.hpp>
+#include <labrat/lbot/node.hpp>
+#include <labrat/lbot/statistics.hpp>
+#include <labrat/lbot/topic.hpp>
+#include <labrat/lbot/tracing.hpp>
+#include <labrat/lbot/utils/thread.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+inline namespace labrat {
+namespace lbot {
+
+class Statistics::Private
+{
+public:
+  class Node;
+
+  // Name of the node within the "/lbot" namespace, which is reserved for internal use.
+  static constexpr const char *node_name = "/lbot/statistics";
+
+  std::shared_ptr<Node> node;
+};
+
+static Statistics::Private priv;
+
+class Statistics::Private::Node : public UniqueNode
+{
+public:
+  Node(TopicMap &topic_map, std::chrono::milliseconds interval) :
+    topic_map(topic_map)
+  {
+    sender = addSender<TopicStatistics>("/lbot/stats/topics");
+#ifdef LBOT_ENABLE_TRACING
+    sender_latency = addSender<LatencyStatistics>("/lbot/stats/latency");
+#endif
+
+    last_sample = Clock::now();
+
+    thread = TimerThread(&Node::timerFunction, interval, "statistics", 1, this);
+  }
+
+private:
+  /**
+   * @brief Values of the counters of a topic at the time of the previous sample.
+   *
+   */
+  struct Snapshot
+  {
+    u64 message_count = 0;
+    u64 byte_count = 0;
+    u64 dropped_count = 0;
+    u64 overwritten_count = 0;
+    u64 callback_count = 0;
+    u64 callback_time = 0;
+  };
+
+  void timerFunction()
+  {
+    const Clock::time_point now = Clock::now();
+    const std::chrono::nanoseconds interval = now - last_sample;
+    last_sample = now;
+
+    const float seconds = std::chrono::duration<float>(interval).count();
+
+    Message<TopicStatistics> message;
+    message.interval = interval.count();
+
+    topic_map.forEachTopic([this, seconds, &message](TopicMap::Topic &topic) {
+      const TopicMap::Topic::Counters &counters = topic.counters;
+      Snapshot &previous = snapshots[topic.name];
+      const TopicMap::Topic::Consumers consumers = topic.getConsumers();
+
+      const Snapshot current = {
+        .message_count = counters.message_count.load(std::memory_order_relaxed),
+        .byte_count = counters.byte_count.load(std::memory_order_relaxed),
+        .dropped_count = counters.dropped_count.load(std::memory_order_relaxed),
+        .overwritten_count = counters.overwritten_count.load(std::memory_order_relaxed),
+        .callback_count = counters.callback_count.load(std::memory_order_relaxed),
+        .callback_time = counters.callback_time.load(std::memory_order_relaxed),
+      };
+
+      std::unique_ptr<TopicStatisticsEntryNative> entry = std::make_unique<TopicStatisticsEntryNative>();
+      entry->topic_name = topic.name;
+      entry->receiver_count =
+        consumers.getReceivers().size() + consumers.getConstReceivers().size() + consumers.getViewReceivers().size();
+      entry->message_count = current.message_count - previous.message_count;
+      entry->byte_count = current.byte_count - previous.byte_count;
+      entry->dropped_count = current.dropped_count - previous.dropped_count;
+      entry->overwritten_count = current.overwritten_count - previous.overwritten_count;
+      entry->max_lag = topic.counters.max_lag.exchange(0, std::memory_order_relaxed);
+      entry->callback_count = current.callback_count - previous.callback_count;
+      entry->callback_time = current.callback_time - previous.callback_time;
+
+      if (seconds > 0) {
+        entry->message_rate = entry->message_count / seconds;
+        entry->byte_rate = entry->byte_count / seconds;
+      }
+
+      previous = current;
+
+#ifdef LBOT_ENABLE_TRACING
+      topic_names.try_emplace(std::hash<std::string>()(topic.name), topic.name);
+#endif
+
+      message.topics.emplace_back(std::move(entry));
+    });
+
+    sender->put(std::move(message));
+
+#ifdef LBOT_ENABLE_TRACING
+    publishLatency(interval);
+#endif
+  }
+
+#ifdef LBOT_ENABLE_TRACING
+  void publishLatency(std::chrono::nanoseconds interval)
+  {
+    Message<LatencyStatistics> message;
+    message.interval = interval.count();
+
+    Tracer::forEachPath([this, &message](std::span<const std::size_t> topics, Tracer::Histogram &histogram) {
+      const u64 count = histogram.count.exchange(0, std::memory_order_relaxed);
+
+      if (count == 0) {
+        return;
+      }
+
+      std::unique_ptr<LatencyPathNative> path = std::make_unique<LatencyPathNative>();
+      path->topics.reserve(topics.size());
+
+      for (std::size_t topic_hash : topics) {
+        const std::unordered_map<std::size_t, std::string>::const_iterator iterator = topic_names.find(topic_hash);
+        path->topics.emplace_back(iterator == topic_names.end() ? std::string() : iterator->second);
+      }
+
+      path->count = count;
+      path->mean_latency = histogram.latency_sum.exchange(0, std::memory_order_relaxed) / count;
+      path->max_latency = histogram.latency_max.exchange(0, std::memory_order_relaxed);
+
+      path->buckets.reserve(Tracer::bucket_count);
+
+      for (std::atomic<u64> &bucket : histogram.buckets) {
+        path->buckets.emplace_back(bucket.exchange(0, std::memory_order_relaxed));
+      }
+
+      message.paths.emplace_back(std::move(path));
+    });
+
+    sender_latency->put(std::move(message));
+  }
+#endif
+
+  TopicMap &topic_map;
+  Sender<TopicStatistics>::Ptr sender;
+#ifdef LBOT_ENABLE_TRACING
+  Sender<LatencyStatistics>::Ptr sender_latency;
+
+  // Names of the topics by the hashes used in traces.
+  std::unordered_map<std::size_t, std::string> topic_names;
+#endif
+
+  Clock::time_point last_sample;
+  // Snapshots by topic name, as several topics may share the same message type and therefore the same handle.
+  std::unordered_map<std::string, Snapshot> snapshots;
+
+  TimerThread thread;
+};
+
+void Statistics::initialize()
+{
+  const int interval = Config::get()->getParameterFallback("/lbot/statistics/interval", 0).get<int>();
+
+  if (interval <= 0) {
+    return;
+  }
+
+  const Manager::Ptr manager = Manager::get();
+
+  TopicMap::Topic::Counters::enabled_flag.store(true);
+
+  priv.node = manager->addNode<Private::Node>(Private::node_name, manager->topic_map, std::chrono::milliseconds(interval));
+}
+
+void Statistics::deinitialize(Manager &manager)
+{
+  if (priv.node == nullptr) {
+    return;
+  }
+
+  priv.node.reset();
+  manager.removeNode(Private::node_name);
+
+  TopicMap::Topic::Counters::enabled_flag.store(false);
+}
+
+}  // namespace lbot
+}  // namespace labrat
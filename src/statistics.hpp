@@ -0,0 +1,46 @@
+/**
+ * @file statistics.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+
+class Manager;
+
+/** @cond INTERNAL */
+/**
+ * @brief Periodic publisher of the runtime statistics of all topics.
+ * @details The statistics are published on the topic "/lbot/stats/topics" every "/lbot/statistics/interval" milliseconds. An interval of
+ * zero disables the statistics, in which case senders and receivers skip all accounting. The publishing node is registered under the
+ * reserved name "/lbot/statistics".
+ *
+ */
+class Statistics
+{
+public:
+  class Private;
+
+  Statistics() = delete;
+
+private:
+  static void initialize();
+  static void deinitialize(Manager &manager);
+
+  friend class Manager;
+};
+/** @endcond */
+
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -14,33 +14,87 @@
 inline namespace labrat {
 namespace lbot {
 
+std::atomic<bool> TopicMap::Topic::Counters::enabled_flag = false;
+
 TopicMap::TopicMap() = default;
 
-TopicMap::Topic::Topic(Handle handle, std::string name) :
+TopicMap::Topic::Topic(Handle handle, std::string name, std::vector<PluginCallback> plugins) :
+  consumer_set(new ConsumerSet{.receivers = {}, .const_receivers = {}, .view_receivers = {}, .plugins = std::move(plugins)}),
   handle(handle),
   name(std::move(name))
 {
-  sender = nullptr;
+  shared_senders = false;
+}
+
+TopicMap::Topic::~Topic()
+{
+  delete consumer_set.load();
 }
 
 void TopicMap::forceFlush()
 {
-  for (std::pair<const std::string, Topic> &entry : map) {
-    for (void *pointer : entry.second.getReceivers()) {
+  forEachTopic([](Topic &topic) -> void {
+    const Topic::Consumers consumers = topic.getConsumers();
+
+    for (void *pointer : consumers.getReceivers()) {
+      Node::GenericReceiver<void> *receiver = reinterpret_cast<Node::GenericReceiver<void> *>(pointer);
+
+      receiver->invalidate();
+    }
+
+    for (void *pointer : consumers.getViewReceivers()) {
       Node::GenericReceiver<void> *receiver = reinterpret_cast<Node::GenericReceiver<void> *>(pointer);
 
-      receiver->flush_flag = true;
-      receiver->condition.notify_one();
+      receiver->invalidate();
+    }
+  });
+}
+
+void TopicMap::addPlugin(const PluginCallback &plugin, const Filter &filter)
+{
+  std::lock_guard guard(map_mutex);
+
+  plugins.emplace_back(PluginEntry{.callback = plugin, .filter = filter});
+
+  for (std::pair<const std::string, Topic> &entry : map) {
+    if (filter.check(entry.first)) {
+      entry.second.addPlugin(plugin);
     }
   }
 }
 
+void TopicMap::removePlugin(void *plugin)
+{
+  std::vector<Topic *> changed_topics;
+
+  {
+    std::lock_guard guard(map_mutex);
+
+    std::erase_if(plugins, [plugin](const PluginEntry &entry) {
+      return entry.callback.user_ptr == plugin;
+    });
+
+    for (std::pair<const std::string, Topic> &entry : map) {
+      if (entry.second.removePlugin(plugin)) {
+        changed_topics.emplace_back(&entry.second);
+      }
+    }
+  }
+
+  // Topics are never removed from the map. Senders are waited for without holding the mutex, as they might create topics themselves.
+  for (Topic *topic : changed_topics) {
+    topic->synchronize();
+  }
+}
+
 TopicMap::Topic &TopicMap::getTopicInternal(const std::string &topic)
 {
   if (topic.empty()) {
     throw ManagementException("Topic name name must be non-empty.");
   }
 
+  std::lock_guard guard(map_mutex);
+
   const std::unordered_map<std::string, Topic>::iterator iterator = map.find(topic);
 
   if (iterator == map.end()) {
@@ -56,8 +110,26 @@ TopicMap::Topic &TopicMap::getTopicInternal(const std::string &topic, Topic::Han
     throw ManagementException("Topic name name must be non-empty.");
   }
 
-  TopicMap::Topic &result =
-    map.emplace(std::piecewise_construct, std::forward_as_tuple(topic), std::forward_as_tuple(handle, topic)).first->second;
+  std::lock_guard guard(map_mutex);
+
+  std::unordered_map<std::string, Topic>::iterator iterator = map.find(topic);
+
+  if (iterator == map.end()) {
+    std::vector<PluginCallback> topic_plugins;
+
+    // Filters are only evaluated once per topic, senders use the resulting list of plugins.
+    for (const PluginEntry &entry : plugins) {
+      if (entry.filter.check(topic)) {
+        topic_plugins.emplace_back(entry.callback);
+      }
+    }
+
+    iterator =
+      map.emplace(std::piecewise_construct, std::forward_as_tuple(topic), std::forward_as_tuple(handle, topic, std::move(topic_plugins)))
+        .first;
+  }
+
+  TopicMap::Topic &result = iterator->second;
 
   if (handle != result.handle) {
     throw ManagementException("Topic '" + topic + "' does not match the provided handle.");
@@ -66,56 +138,114 @@ TopicMap::Topic &TopicMap::getTopicInternal(const std::string &topic, Topic::Han
   return result;
 }
 
-void *TopicMap::Topic::getSender() const
+bool TopicMap::Topic::addSender(void *new_sender, bool shared)
 {
-  return sender;
-}
+  std::lock_guard guard(change_mutex);
 
-void TopicMap::Topic::addSender(void *new_sender)
-{
-  if (sender != nullptr) {
+  if (!senders.empty() && !(shared && shared_senders)) {
     throw ManagementException("A sender has already been registered for this topic.");
   }
 
-  sender = new_sender;
+  senders.emplace_back(new_sender);
+  shared_senders = shared;
+
+  return senders.size() == 1;
 }
 
-void TopicMap::Topic::removeSender(void *old_sender)
+bool TopicMap::Topic::removeSender(void *old_sender)
 {
-  if (sender != old_sender) {
+  std::lock_guard guard(change_mutex);
+
+  const std::vector<void *>::iterator iterator = std::find(senders.begin(), senders.end(), old_sender);
+
+  if (iterator == senders.end()) {
     throw ManagementException("The sender to be removed does not match the existing sender.");
   }
 
-  sender = nullptr;
+  senders.erase(iterator);
+
+  return senders.empty();
 }
 
-void TopicMap::Topic::addReceiver(void *new_receiver, bool is_const)
+template <typename Function>
+bool TopicMap::Topic::updateConsumers(Function &&function)
 {
-  FlagGuard guard(change_flag);
-  waitUntil<std::size_t>(use_count, 0);
+  std::lock_guard guard(change_mutex);
+
+  std::unique_ptr<ConsumerSet> new_set = std::make_unique<ConsumerSet>(*consumer_set.load());
 
-  if (is_const) {
-    const_receivers.emplace_back(new_receiver);
-  } else {
-    receivers.emplace_back(new_receiver);
+  if (!function(*new_set)) {
+    return false;
   }
+
+  // Senders might still iterate over the old snapshot, so it is only deleted once they are done. This never waits for them.
+  epoch_domain.retire(std::unique_ptr<const ConsumerSet>(consumer_set.exchange(new_set.release())));
+
+  return true;
 }
 
-void TopicMap::Topic::removeReceiver(void *old_receiver)
+void TopicMap::Topic::addReceiver(void *new_receiver, bool is_const)
 {
-  FlagGuard guard(change_flag);
-  waitUntil<std::size_t>(use_count, 0);
+  updateConsumers([new_receiver, is_const](ConsumerSet &set) -> bool {
+    if (is_const) {
+      set.const_receivers.emplace_back(new_receiver);
+    } else {
+      set.receivers.emplace_back(new_receiver);
+    }
 
-  std::vector<void *>::iterator iterator = std::find(receivers.begin(), receivers.end(), old_receiver);
-  std::vector<void *>::iterator const_iterator = std::find(const_receivers.begin(), const_receivers.end(), old_receiver);
+    return true;
+  });
+}
+
+void TopicMap::Topic::addViewReceiver(void *new_receiver)
+{
+  updateConsumers([new_receiver](ConsumerSet &set) -> bool {
+    set.view_receivers.emplace_back(new_receiver);
+
+    return true;
+  });
+}
+
+void TopicMap::Topic::removeReceiver(void *old_receiver)
+{
+  updateConsumers([old_receiver](ConsumerSet &set) -> bool {
+    for (std::vector<void *> *list : {&set.receivers, &set.const_receivers, &set.view_receivers}) {
+      const std::vector<void *>::iterator iterator = std::find(list->begin(), list->end(), old_receiver);
+
+      if (iterator != list->end()) {
+        list->erase(iterator);
+        return true;
+      }
+    }
 
-  if (iterator != receivers.end()) {
-    receivers.erase(iterator);
-  } else if (const_iterator != const_receivers.end()) {
-    const_receivers.erase(const_iterator);
-  } else {
     throw ManagementException("Receiver to be removed not found.");
-  }
+  });
+
+  // Wait for all senders still iterating over an old snapshot. Afterwards, the receiver is no longer accessed.
+  synchronize();
+}
+
+void TopicMap::Topic::addPlugin(const PluginCallback &new_plugin)
+{
+  updateConsumers([&new_plugin](ConsumerSet &set) -> bool {
+    set.plugins.emplace_back(new_plugin);
+
+    return true;
+  });
+}
+
+bool TopicMap::Topic::removePlugin(void *old_plugin)
+{
+  return updateConsumers([old_plugin](ConsumerSet &set) -> bool {
+    return std::erase_if(set.plugins, [old_plugin](const PluginCallback &plugin) {
+      return plugin.user_ptr == old_plugin;
+    }) != 0;
+  });
+}
+
+void TopicMap::Topic::synchronize()
+{
+  epoch_domain.synchronize();
 }
 
 }  // namespace lbot
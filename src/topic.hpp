@@ -9,13 +9,16 @@
 #pragma once
 
 #include <labrat/lbot/base.hpp>
+#include <labrat/lbot/filter.hpp>
 #include <labrat/lbot/message.hpp>
-#include <labrat/lbot/utils/atomic.hpp>
+#include <labrat/lbot/utils/epoch.hpp>
 #include <labrat/lbot/utils/types.hpp>
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -26,133 +29,262 @@ inline namespace labrat {
 /** @endcond */
 namespace lbot {
 
+struct MessageInfo;
+class Statistics;
+
 /** @cond INTERNAL */
 class TopicMap
 {
 public:
+  /**
+   * @brief Message callback of a plugin interested in a topic.
+   *
+   */
+  struct PluginCallback
+  {
+    using Function = void (*)(void *plugin, const MessageInfo &info);
+
+    void *user_ptr;
+    Function function;
+  };
+
   class Topic
   {
   private:
-    void *sender;
-    std::vector<void *> receivers;
-    std::vector<void *> const_receivers;
+    /**
+     * @brief Immutable snapshot of the receivers and plugins of a topic.
+     * Changes are applied to a copy which then replaces the current snapshot, so that senders never have to wait for them.
+     *
+     */
+    struct ConsumerSet
+    {
+      std::vector<void *> receivers;
+      std::vector<void *> const_receivers;
+      std::vector<void *> view_receivers;
+      std::vector<PluginCallback> plugins;
+    };
+
+    // Guarded by the change mutex.
+    std::vector<void *> senders;
+    bool shared_senders;
 
-    std::atomic_flag change_flag;
-    std::atomic<std::size_t> use_count;
+    std::atomic<const ConsumerSet *> consumer_set;
+    std::mutex change_mutex;
 
-    friend class ReceiverList;
+    // Removing a consumer only waits for the senders of this topic.
+    EpochDomain<16> epoch_domain;
+
+    template <typename Function>
+    bool updateConsumers(Function &&function);
 
   public:
     using Handle = std::size_t;
 
-    class ReceiverList
+    /**
+     * @brief Snapshot of all consumers of a topic.
+     * All consumer lists are read from the same snapshot under a single epoch guard, so that a sender only enters the epoch domain once per
+     * operation. Consumers removed after the snapshot has been taken stay valid until the snapshot is released.
+     *
+     */
+    class Consumers
     {
     public:
-      explicit inline ReceiverList(Topic &topic, bool is_const) :
-        topic(topic),
-        receivers(is_const ? topic.const_receivers : topic.receivers)
+      explicit inline Consumers(Topic &topic) :
+        guard(topic.epoch_domain),
+        set(*topic.consumer_set.load())
+      {}
+
+      Consumers(const Consumers &) = delete;
+
+      [[nodiscard]] inline const std::vector<void *> &getReceivers() const
       {
-        while (true) {
-          topic.use_count.fetch_add(1);
+        return set.receivers;
+      }
 
-          [[likely]] if (!topic.change_flag.test()) {
-            break;
-          }
+      [[nodiscard]] inline const std::vector<void *> &getConstReceivers() const
+      {
+        return set.const_receivers;
+      }
 
-          topic.use_count.fetch_sub(1);
-          topic.use_count.notify_all();
-          topic.change_flag.wait(true);
-        }
+      [[nodiscard]] inline const std::vector<void *> &getViewReceivers() const
+      {
+        return set.view_receivers;
       }
 
-      inline ReceiverList(ReceiverList &&rhs) noexcept :
-        topic(rhs.topic),
-        receivers(rhs.receivers)
+      [[nodiscard]] inline const std::vector<PluginCallback> &getPlugins() const
       {
-        topic.use_count.fetch_add(1);
+        return set.plugins;
       }
 
-      inline ~ReceiverList()
+    private:
+      // The guard must be initialized before the snapshot is loaded.
+      const EpochDomain<16>::Guard guard;
+      const ConsumerSet &set;
+    };
+
+    /**
+     * @brief Counters of the activity on a topic.
+     * They are updated with relaxed atomic operations and sampled periodically to compute the statistics of the topic. The counters are
+     * kept on their own cache line, so that they do not slow down senders loading the consumer set. While the statistics are disabled,
+     * no counter is updated.
+     *
+     */
+    struct alignas(64) Counters
+    {
+      /**
+       * @brief Check whether the counters are to be updated.
+       * Callers should skip any work only required to update the counters when this returns false.
+       *
+       * @return true When the statistics are enabled.
+       */
+      [[nodiscard]] static inline bool enabled()
       {
-        topic.use_count.fetch_sub(1);
-        topic.use_count.notify_all();
+        return enabled_flag.load(std::memory_order_relaxed);
       }
 
-      [[nodiscard]] inline std::vector<void *>::iterator begin() const
+      inline void countMessages(u64 count)
       {
-        return receivers.begin();
+        if (enabled()) {
+          message_count.fetch_add(count, std::memory_order_relaxed);
+        }
       }
 
-      [[nodiscard]] inline std::vector<void *>::iterator end() const
+      inline void countBytes(u64 count)
       {
-        return receivers.end();
+        if (enabled()) {
+          byte_count.fetch_add(count, std::memory_order_relaxed);
+        }
       }
 
-      [[nodiscard]] inline std::size_t size() const
+      inline void countDropped()
       {
-        return receivers.size();
+        if (enabled()) {
+          dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
       }
 
-    private:
-      Topic &topic;
-      std::vector<void *> &receivers;
-    };
+      inline void countOverwritten(u64 count)
+      {
+        if (enabled()) {
+          overwritten_count.fetch_add(count, std::memory_order_relaxed);
+        }
+      }
+
+      inline void countCallback(std::chrono::nanoseconds duration)
+      {
+        callback_count.fetch_add(1, std::memory_order_relaxed);
+        callback_time.fetch_add(duration.count(), std::memory_order_relaxed);
+      }
+
+      std::atomic<u64> message_count = 0;
+      std::atomic<u64> byte_count = 0;
+      std::atomic<u64> dropped_count = 0;
+      std::atomic<u64> overwritten_count = 0;
+      std::atomic<u64> callback_count = 0;
+      std::atomic<u64> callback_time = 0;
+      std::atomic<u64> max_lag = 0;
+
+      /**
+       * @brief Record the number of unread messages a receiver has encountered on a read operation.
+       *
+       * @param lag Number of unread messages.
+       */
+      inline void recordLag(u64 lag)
+      {
+        if (!enabled()) {
+          return;
+        }
 
-    Topic(Handle handle, std::string name);
+        u64 previous = max_lag.load(std::memory_order_relaxed);
 
-    [[nodiscard]] void *getSender() const;
-    void addSender(void *new_sender);
-    void removeSender(void *old_sender);
+        while (previous < lag && !max_lag.compare_exchange_weak(previous, lag, std::memory_order_relaxed)) {}
+      }
 
-    [[nodiscard]] inline ReceiverList getReceivers()
-    {
-      return ReceiverList(*this, false);
-    }
+    private:
+      static std::atomic<bool> enabled_flag;
+
+      friend class lbot::Statistics;
+    };
 
-    [[nodiscard]] inline ReceiverList getConstReceivers()
+    Topic(Handle handle, std::string name, std::vector<PluginCallback> plugins);
+    ~Topic();
+
+    /**
+     * @brief Add a sender to the topic.
+     *
+     * @param new_sender Sender to be added.
+     * @param shared Whether the sender allows other senders on the topic.
+     * @return true When the sender is the first sender of the topic.
+     * @return false When other senders have already been registered.
+     * @throw ManagementException When the topic is already claimed by an exclusive sender.
+     */
+    bool addSender(void *new_sender, bool shared);
+
+    /**
+     * @brief Remove a sender from the topic.
+     *
+     * @param old_sender Sender to be removed.
+     * @return true When the sender was the last sender of the topic.
+     * @return false When other senders remain.
+     */
+    bool removeSender(void *old_sender);
+
+    [[nodiscard]] inline Consumers getConsumers()
     {
-      return ReceiverList(*this, true);
+      return Consumers(*this);
     }
 
     void addReceiver(void *new_receiver, bool is_const);
+    void addViewReceiver(void *new_receiver);
+    /**
+     * @brief Remove a receiver from the topic.
+     * Once this returns, the receiver will no longer be accessed by senders. As this waits for all senders of the topic that have started
+     * before, it must not be called from within a callback of a receiver of the same topic.
+     *
+     * @param old_receiver Receiver to be removed.
+     */
     void removeReceiver(void *old_receiver);
 
+    void addPlugin(const PluginCallback &new_plugin);
+
+    /**
+     * @brief Remove the message callback of a plugin from the topic.
+     * Senders that have started before might still call it until synchronize() returns.
+     *
+     * @param old_plugin User pointer of the plugin.
+     * @return true When the plugin has been removed.
+     * @return false When the plugin was not registered for the topic.
+     */
+    bool removePlugin(void *old_plugin);
+
+    /**
+     * @brief Wait for all senders of the topic that have started before the call.
+     * This must not be called from within a callback of a receiver of the topic.
+     *
+     */
+    void synchronize();
+
     const Handle handle;
     const std::string name;
+
+    Counters counters;
   };
 
   TopicMap();
   ~TopicMap() = default;
 
-  template <typename T>
-  requires is_message<T>
-  Topic &addSender(const std::string &topic_name, void *sender)
-  {
-    Topic &topic = getTopicInternal(topic_name, typeid(typename std::remove_const_t<T>::Content).hash_code());
-
-    topic.addSender(sender);
-
-    return topic;
-  }
-
-  Topic &removeSender(const std::string &topic_name, void *sender)
+  bool removeSender(const std::string &topic_name, void *sender)
   {
     Topic &topic = getTopicInternal(topic_name);
 
-    topic.removeSender(sender);
-
-    return topic;
+    return topic.removeSender(sender);
   }
 
   template <typename T>
   requires is_message<T>
-  Topic &addReceiver(const std::string &topic_name, void *receiver)
+  Topic &getTopic(const std::string &topic_name)
   {
-    Topic &topic = getTopicInternal(topic_name, typeid(typename std::remove_const_t<T>::Content).hash_code());
-
-    topic.addReceiver(receiver, is_const_message<T>);
-
-    return topic;
+    return getTopicInternal(topic_name, typeid(typename std::remove_const_t<T>::Content).hash_code());
   }
 
   Topic &removeReceiver(const std::string &topic_name, void *receiver)
@@ -164,13 +296,53 @@ public:
     return topic;
   }
 
+  /**
+   * @brief Add the message callback of a plugin to all current and future topics that pass its filter.
+   *
+   * @param plugin Message callback of the plugin.
+   * @param filter Topic filter of the plugin.
+   */
+  void addPlugin(const PluginCallback &plugin, const Filter &filter);
+
+  /**
+   * @brief Remove the message callback of a plugin from all topics.
+   * Once this returns, the callback will no longer be called.
+   *
+   * @param plugin User pointer of the plugin.
+   */
+  void removePlugin(void *plugin);
+
   void forceFlush();
 
+  /**
+   * @brief Call a function for each topic.
+   * Topics cannot be created while the function is being called.
+   *
+   * @param function Function to be called with a reference to each topic.
+   */
+  template <typename Function>
+  void forEachTopic(Function &&function)
+  {
+    std::lock_guard guard(map_mutex);
+
+    for (std::pair<const std::string, Topic> &entry : map) {
+      function(entry.second);
+    }
+  }
+
 private:
+  struct PluginEntry
+  {
+    PluginCallback callback;
+    Filter filter;
+  };
+
   Topic &getTopicInternal(const std::string &topic);
   Topic &getTopicInternal(const std::string &topic, std::size_t handle);
 
   std::unordered_map<std::string, Topic> map;
+  std::mutex map_mutex;
+  std::vector<PluginEntry> plugins;
 };
 /** @endcond  */
 
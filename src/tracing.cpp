@@ -0,0 +1,136 @@
+/**
+ * @file tracing.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/tracing.hpp>
+
+#ifdef LBOT_ENABLE_TRACING
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+inline namespace labrat {
+namespace lbot {
+
+struct TracePath
+{
+  std::vector<std::size_t> topics;
+  std::unique_ptr<Tracer::Histogram> histogram;
+};
+
+static std::atomic<u64> next_sequence_id;
+static thread_local const TraceContext *current_context = nullptr;
+
+static std::shared_mutex path_mutex;
+static std::unordered_map<std::size_t, TracePath> path_map;
+
+/**
+ * @brief Get the histogram of the path a message has taken.
+ * The histogram is created upon first use.
+ *
+ * @param context Context of the message.
+ * @return Tracer::Histogram& Histogram of the path.
+ */
+static Tracer::Histogram &getHistogram(const TraceContext &context)
+{
+  std::size_t key = 0;
+
+  for (const TraceContext::Hop &hop : context.getHops()) {
+    key ^= hop.topic_hash + 0x9e3779b9 + (key << 6) + (key >> 2);
+  }
+
+  {
+    std::shared_lock lock(path_mutex);
+
+    const std::unordered_map<std::size_t, TracePath>::iterator iterator = path_map.find(key);
+
+    if (iterator != path_map.end()) {
+      return *iterator->second.histogram;
+    }
+  }
+
+  std::unique_lock lock(path_mutex);
+
+  TracePath &path = path_map[key];
+
+  if (!path.histogram) {
+    for (const TraceContext::Hop &hop : context.getHops()) {
+      path.topics.emplace_back(hop.topic_hash);
+    }
+
+    path.histogram = std::make_unique<Tracer::Histogram>();
+  }
+
+  return *path.histogram;
+}
+
+Tracer::CallbackScope::CallbackScope(const TraceContext &context) :
+  previous(current_context)
+{
+  current_context = &context;
+
+  // Messages that have not been sent over a topic do not belong to a trace.
+  if (context.hop_count == 0) {
+    return;
+  }
+
+  const u64 latency = std::max<i64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - context.origin).count(), 0);
+  const std::size_t bucket = std::min<std::size_t>(std::bit_width(latency / 1000), bucket_count - 1);
+
+  Histogram &histogram = getHistogram(context);
+
+  histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.latency_sum.fetch_add(latency, std::memory_order_relaxed);
+
+  u64 previous_max = histogram.latency_max.load(std::memory_order_relaxed);
+  while (previous_max < latency && !histogram.latency_max.compare_exchange_weak(previous_max, latency, std::memory_order_relaxed)) {}
+}
+
+Tracer::CallbackScope::~CallbackScope()
+{
+  current_context = previous;
+}
+
+TraceContext Tracer::publish(std::size_t topic_hash, Clock::time_point timestamp, std::size_t count)
+{
+  TraceContext result;
+
+  if (current_context != nullptr && current_context->hop_count != 0) {
+    result = *current_context;
+  } else {
+    result.sequence_id = next_sequence_id.fetch_add(count, std::memory_order_relaxed);
+    result.origin = timestamp;
+  }
+
+  if (result.hop_count < TraceContext::max_hops) {
+    result.hops[result.hop_count] = TraceContext::Hop{.topic_hash = topic_hash, .timestamp = timestamp};
+    ++result.hop_count;
+  }
+
+  return result;
+}
+
+void Tracer::forEachPathInternal(PathFunction function, void *user_ptr)
+{
+  std::shared_lock lock(path_mutex);
+
+  for (std::pair<const std::size_t, TracePath> &entry : path_map) {
+    function(user_ptr, entry.second.topics, *entry.second.histogram);
+  }
+}
+
+}  // namespace lbot
+}  // namespace labrat
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file tracing.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+
+#ifdef LBOT_ENABLE_TRACING
+/**
+ * @brief Context to trace a message across multiple topics.
+ * @details A message sent from within a receiver callback inherits the context of the message that has been passed to the callback.
+ * The context of a message is available through MessageTime::getTraceContext() when lbot has been built with the ENABLE_TRACING option.
+ *
+ */
+struct TraceContext
+{
+  /** Maximum number of topics recorded by a trace. Further topics are not recorded. */
+  static constexpr std::size_t max_hops = 8;
+
+  /**
+   * @brief Topic a traced message has been sent over.
+   *
+   */
+  struct Hop
+  {
+    /** Hash of the topic name. */
+    std::size_t topic_hash;
+    /** Time at which the message has been sent over the topic. */
+    Clock::time_point timestamp;
+  };
+
+  /** Sequence number of the message that started the trace. */
+  u64 sequence_id = 0;
+  /** Time at which the message that started the trace has been sent. */
+  Clock::time_point origin;
+  /** Number of recorded topics. A context without any topics does not belong to a trace. */
+  u8 hop_count = 0;
+  /** Topics the message and its predecessors have been sent over. */
+  std::array<Hop, max_hops> hops;
+
+  /**
+   * @brief Get the topics the message and its predecessors have been sent over.
+   *
+   * @return std::span<const Hop> Recorded topics in the order they have been sent over.
+   */
+  [[nodiscard]] inline std::span<const Hop> getHops() const
+  {
+    return std::span<const Hop>(hops.data(), hop_count);
+  }
+};
+#else
+/**
+ * @brief Empty context to trace a message across multiple topics.
+ * @details lbot has been built without the ENABLE_TRACING option, so no data is recorded.
+ *
+ */
+struct TraceContext
+{};
+#endif
+
+/** @cond INTERNAL */
+/**
+ * @brief Recorder of the traces of all messages.
+ * @details Whenever a traced message is passed to a receiver callback, the latency since the start of its trace is recorded in a histogram
+ * of the path the message has taken. Without the ENABLE_TRACING option, all functions are no-ops.
+ *
+ */
+class Tracer
+{
+public:
+  /** Number of buckets of a latency histogram. Bucket 0 counts latencies below 1us, bucket i latencies from 2^(i - 1)us up to 2^i us. */
+  static constexpr std::size_t bucket_count = 32;
+
+  /**
+   * @brief Latency histogram of a path.
+   *
+   */
+  struct Histogram
+  {
+    std::array<std::atomic<u64>, bucket_count> buckets = {};
+    std::atomic<u64> count = 0;
+    std::atomic<u64> latency_sum = 0;
+    std::atomic<u64> latency_max = 0;
+  };
+
+  /**
+   * @brief RAII guard to provide the context of a message to everything sent from within a receiver callback.
+   *
+   */
+  class CallbackScope
+  {
+  public:
+#ifdef LBOT_ENABLE_TRACING
+    /**
+     * @brief Record the latency of the message and make its context the current one of this thread.
+     *
+     * @param context Context of the message passed to the callback.
+     */
+    explicit CallbackScope(const TraceContext &context);
+    ~CallbackScope();
+
+  private:
+    const TraceContext *const previous;
+#else
+    explicit inline CallbackScope(const TraceContext &) {}
+#endif
+  };
+
+  Tracer() = delete;
+
+#ifdef LBOT_ENABLE_TRACING
+  /**
+   * @brief Get the context of messages about to be sent over a topic.
+   * Within a receiver callback, the context of the message passed to the callback is continued. Otherwise a new trace is started.
+   *
+   * @param topic_hash Hash of the topic name.
+   * @param timestamp Timestamp of the messages.
+   * @param count Number of messages to be sent at once.
+   * @return TraceContext Context of the first message.
+   */
+  static TraceContext publish(std::size_t topic_hash, Clock::time_point timestamp, std::size_t count = 1);
+
+  /**
+   * @brief Get the context of a message sent as part of a batch.
+   *
+   * @param context Context returned by publish().
+   * @param index Index of the message within the batch.
+   * @return TraceContext Context of the message.
+   */
+  static inline TraceContext getBatchContext(const TraceContext &context, std::size_t index)
+  {
+    TraceContext result = context;
+
+    // Only messages starting a new trace have sequence numbers of their own.
+    if (result.hop_count == 1) {
+      result.sequence_id += index;
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Call a function for the histogram of each path that has been recorded.
+   *
+   * @param function Function to be called with the topic hashes of the path and its histogram.
+   */
+  template <typename Function>
+  static void forEachPath(Function &&function)
+  {
+    forEachPathInternal(
+      [](void *user_ptr, std::span<const std::size_t> topics, Histogram &histogram) {
+        (*reinterpret_cast<std::remove_reference_t<Function> *>(user_ptr))(topics, histogram);
+      },
+      &function
+    );
+  }
+
+private:
+  using PathFunction = void (*)(void *user_ptr, std::span<const std::size_t> topics, Histogram &histogram);
+
+  static void forEachPathInternal(PathFunction function, void *user_ptr);
+#else
+  static inline TraceContext publish(std::size_t, Clock::time_point, std::size_t = 1)
+  {
+    return {};
+  }
+
+  static inline TraceContext getBatchContext(const TraceContext &, std::size_t)
+  {
+    return {};
+  }
+
+  template <typename Function>
+  static void forEachPath(Function &&)
+  {}
+#endif
+};
+/** @endcond */
+
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -29,6 +29,9 @@ enum class ExecutionPolicy
   /** A new thread will be created. This allows multiple callbacks to be executed concurrently. Preferred for callbacks with a large
    * computational cost. */
   parallel,
+  /** The callback will be submitted to a persistent pool of worker threads. This allows multiple callbacks to be executed concurrently
+   * without creating a new thread per call. */
+  pooled,
 };
 
 /** @cond INTERNAL */
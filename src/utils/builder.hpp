@@ -0,0 +1,115 @@
+/**
+ * @file builder.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <flatbuffers/flatbuffers.h>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+/**
+ * @brief Thread local pool of flatbuffer builders.
+ * @details Builders are cleared instead of destroyed when they are returned to the pool, so that their internal buffers are reused for
+ * subsequent messages. Builders that have grown beyond a size limit are destroyed instead, so that a single large message does not pin its
+ * buffer for the lifetime of the thread. Each thread owns its own pool, hence no synchronization is required.
+ */
+class BuilderPool
+{
+public:
+  /**
+   * @brief Exclusive access to a builder of the pool of the calling thread.
+   * The builder is returned to the pool on destruction. A lease must be destroyed by the thread that created it.
+   *
+   */
+  class Lease
+  {
+  public:
+    Lease() :
+      builder(BuilderPool::acquire())
+    {}
+
+    Lease(const Lease &) = delete;
+
+    ~Lease()
+    {
+      BuilderPool::release(std::move(builder));
+    }
+
+    inline flatbuffers::FlatBufferBuilder &operator*() const
+    {
+      return *builder;
+    }
+
+    inline flatbuffers::FlatBufferBuilder *operator->() const
+    {
+      return builder.get();
+    }
+
+  private:
+    std::unique_ptr<flatbuffers::FlatBufferBuilder> builder;
+  };
+
+private:
+  // Nested leases only occur when a plugin sends out messages itself, so a small pool suffices.
+  static constexpr std::size_t max_size = 4;
+
+  // Builders never shrink their buffers, so builders that have held a larger message are not returned to the pool.
+  static constexpr std::size_t max_builder_size = 1 << 20;
+
+  using Pool = std::vector<std::unique_ptr<flatbuffers::FlatBufferBuilder>>;
+
+  static Pool &getPool()
+  {
+    thread_local Pool pool;
+
+    return pool;
+  }
+
+  static std::unique_ptr<flatbuffers::FlatBufferBuilder> acquire()
+  {
+    Pool &pool = getPool();
+
+    if (pool.empty()) {
+      return std::make_unique<flatbuffers::FlatBufferBuilder>();
+    }
+
+    std::unique_ptr<flatbuffers::FlatBufferBuilder> result = std::move(pool.back());
+    pool.pop_back();
+
+    return result;
+  }
+
+  static void release(std::unique_ptr<flatbuffers::FlatBufferBuilder> &&builder)
+  {
+    Pool &pool = getPool();
+
+    if (pool.size() < max_size && builder->GetSize() <= max_builder_size) {
+      builder->Clear();
+      pool.emplace_back(std::move(builder));
+    }
+  }
+};
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
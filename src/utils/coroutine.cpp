@@ -0,0 +1,279 @@
+/**
+ * @file coroutine.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/exception.hpp>
+#include <labrat/lbot/utils/coroutine.hpp>
+
+#include <utility>
+
+inline namespace labrat {
+namespace lbot {
+inline namespace utils {
+
+thread_local Scheduler *Scheduler::current_scheduler = nullptr;
+
+/**
+ * @brief Detached coroutine owning a top level task of a scheduler.
+ * Once the task has finished, the coroutine reports to the scheduler which then destroys it.
+ *
+ */
+class Scheduler::Root
+{
+public:
+  struct promise_type
+  {
+    struct FinalAwaiter
+    {
+      [[nodiscard]] bool await_ready() const noexcept
+      {
+        return false;
+      }
+
+      void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+      {
+        promise_type &promise = handle.promise();
+        promise.scheduler->finish(handle, std::move(promise.exception));
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    promise_type(Scheduler &scheduler, Task<void> &) :
+      scheduler(&scheduler)
+    {}
+
+    Root get_return_object() noexcept
+    {
+      return Root(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+    {
+      return {};
+    }
+
+    [[nodiscard]] FinalAwaiter final_suspend() const noexcept
+    {
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept
+    {
+      exception = std::current_exception();
+    }
+
+    Scheduler *scheduler;
+    std::exception_ptr exception;
+  };
+
+  explicit Root(std::coroutine_handle<promise_type> handle) :
+    handle(handle)
+  {}
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+Scheduler::Root Scheduler::run(Scheduler &, Task<void> task)
+{
+  co_await std::move(task);
+}
+
+bool Scheduler::Link::schedule(std::coroutine_handle<> handle)
+{
+  // The mutex keeps the scheduler alive while the coroutine is being scheduled.
+  std::lock_guard guard(mutex);
+
+  if (scheduler == nullptr) {
+    return false;
+  }
+
+  scheduler->schedule(handle);
+
+  return true;
+}
+
+Scheduler::Scheduler(std::size_t thread_count, const std::string &name, i32 priority) :
+  stopping(false),
+  link(std::make_shared<Link>(this))
+{
+  executor = std::make_unique<Executor>(thread_count, name, priority);
+  timer_thread = std::jthread([this](std::stop_token token) {
+    timerLoop(token);
+  });
+}
+
+Scheduler::~Scheduler()
+{
+  // Operations still in progress outside of the scheduler must neither access the scheduler nor the coroutines destroyed below.
+  {
+    std::lock_guard guard(link->mutex);
+    link->scheduler = nullptr;
+  }
+
+  {
+    std::lock_guard guard(mutex);
+    stopping = true;
+  }
+
+  timer_thread.request_stop();
+  {
+    std::lock_guard guard(timer_mutex);
+    timer_condition.notifyAll();
+  }
+  timer_thread.join();
+
+  // Wait for the workers to finish the coroutines they are currently running. The executor still runs all pending tasks upon destruction,
+  // but pending resumptions are discarded as the scheduler is stopping.
+  executor.reset();
+
+  std::unordered_set<void *> local_roots;
+  {
+    std::lock_guard guard(mutex);
+    local_roots = std::move(roots);
+  }
+
+  for (void *root : local_roots) {
+    std::coroutine_handle<>::from_address(root).destroy();
+  }
+}
+
+void Scheduler::spawn(Task<void> &&task)
+{
+  if (!task.valid()) {
+    throw InvalidArgumentException("Cannot spawn an invalid task.");
+  }
+
+  const Root root = run(*this, std::move(task));
+
+  {
+    std::lock_guard guard(mutex);
+
+    if (stopping) {
+      root.handle.destroy();
+      return;
+    }
+
+    roots.emplace(root.handle.address());
+  }
+
+  schedule(root.handle);
+}
+
+void Scheduler::wait()
+{
+  std::unique_lock lock(mutex);
+
+  condition.wait(lock, [this]() {
+    return roots.empty();
+  });
+
+  if (exception) {
+    std::rethrow_exception(std::exchange(exception, nullptr));
+  }
+}
+
+void Scheduler::schedule(std::coroutine_handle<> handle)
+{
+  std::lock_guard guard(mutex);
+
+  if (stopping) {
+    return;
+  }
+
+  executor->submit([this, handle]() {
+    if (stopping.load()) {
+      return;
+    }
+
+    current_scheduler = this;
+    handle.resume();
+    current_scheduler = nullptr;
+  });
+}
+
+void Scheduler::scheduleAt(Clock::time_point time, std::coroutine_handle<> handle)
+{
+  std::lock_guard guard(timer_mutex);
+
+  // Only wake up the timer thread when its next deadline changes.
+  const bool earliest = timers.empty() || time < timers.top().time;
+  timers.emplace(TimerEntry{.time = time, .handle = handle});
+
+  if (earliest) {
+    timer_condition.notifyAll();
+  }
+}
+
+Scheduler *Scheduler::current()
+{
+  return current_scheduler;
+}
+
+void Scheduler::finish(std::coroutine_handle<> handle, std::exception_ptr new_exception)
+{
+  std::lock_guard guard(mutex);
+
+  if (new_exception && !exception) {
+    exception = std::move(new_exception);
+  }
+
+  roots.erase(handle.address());
+  handle.destroy();
+
+  if (roots.empty()) {
+    condition.notify_all();
+  }
+}
+
+void Scheduler::timerLoop(std::stop_token token)
+{
+  std::unique_lock lock(timer_mutex);
+
+  while (!token.stop_requested()) {
+    if (timers.empty()) {
+      timer_condition.wait(lock);
+      continue;
+    }
+
+    // Timed waits are only possible once the clock has been initialized.
+    if (!Clock::initialized()) {
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      lock.lock();
+      continue;
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    while (!timers.empty() && timers.top().time <= now) {
+      schedule(timers.top().handle);
+      timers.pop();
+    }
+
+    if (!timers.empty()) {
+      timer_condition.waitUntil(lock, timers.top().time);
+    }
+  }
+}
+
+void SleepAwaiter::await_suspend(std::coroutine_handle<> handle) const
+{
+  Scheduler *scheduler = Scheduler::current();
+
+  if (scheduler == nullptr) {
+    throw BadUsageException("Timed waits of coroutines are only possible from within a scheduler.");
+  }
+
+  scheduler->scheduleAt(time, handle);
+}
+
+}  // namespace utils
+}  // namespace lbot
+}  // namespace labrat
@@ -0,0 +1,443 @@
+/**
+ * @file coroutine.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/clock.hpp>
+#include <labrat/lbot/utils/condition.hpp>
+#include <labrat/lbot/utils/executor.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+template <typename T = void>
+class Task;
+
+/** @cond INTERNAL */
+namespace detail {
+
+template <typename T>
+class TaskPromiseBase
+{
+public:
+  struct FinalAwaiter
+  {
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+      return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+      // Resume the awaiting coroutine directly, so that deep call chains do not grow the stack.
+      const std::coroutine_handle<> continuation = handle.promise().continuation;
+
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+  {
+    return {};
+  }
+
+  [[nodiscard]] FinalAwaiter final_suspend() const noexcept
+  {
+    return {};
+  }
+
+  void unhandled_exception() noexcept
+  {
+    exception = std::current_exception();
+  }
+
+  std::coroutine_handle<> continuation;
+  std::exception_ptr exception;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase<T>
+{
+public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U &&new_value)
+  {
+    value.emplace(std::forward<U>(new_value));
+  }
+
+  T result()
+  {
+    if (TaskPromiseBase<T>::exception) {
+      std::rethrow_exception(TaskPromiseBase<T>::exception);
+    }
+
+    return std::move(*value);
+  }
+
+private:
+  std::optional<T> value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase<void>
+{
+public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void result()
+  {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+};
+
+}  // namespace detail
+/** @endcond */
+
+/**
+ * @brief Lazily started coroutine producing a value of type T.
+ * @details The coroutine starts executing once the task is awaited and resumes the awaiting coroutine when it finishes. Exceptions thrown
+ * by the coroutine are rethrown in the awaiting coroutine. Top level tasks are started by handing them to a Scheduler.
+ *
+ * @tparam T Type of the result of the coroutine.
+ */
+template <typename T>
+class [[nodiscard]] Task
+{
+public:
+  using promise_type = detail::TaskPromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task(const Task &) = delete;
+
+  Task(Task &&rhs) noexcept :
+    handle(std::exchange(rhs.handle, nullptr))
+  {}
+
+  ~Task()
+  {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  Task &operator=(Task &&rhs) noexcept
+  {
+    if (this != &rhs) {
+      if (handle) {
+        handle.destroy();
+      }
+
+      handle = std::exchange(rhs.handle, nullptr);
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Check whether the task refers to a coroutine.
+   *
+   * @return true When the task is valid.
+   */
+  [[nodiscard]] bool valid() const
+  {
+    return static_cast<bool>(handle);
+  }
+
+  auto operator co_await() const &&noexcept
+  {
+    struct Awaiter
+    {
+      [[nodiscard]] bool await_ready() const noexcept
+      {
+        return !handle || handle.done();
+      }
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+      {
+        handle.promise().continuation = awaiting;
+
+        return handle;
+      }
+
+      T await_resume()
+      {
+        return handle.promise().result();
+      }
+
+      Handle handle;
+    };
+
+    return Awaiter{handle};
+  }
+
+  auto operator co_await() const &noexcept
+  {
+    return std::move(*this).operator co_await();
+  }
+
+private:
+  explicit Task(Handle handle) :
+    handle(handle)
+  {}
+
+  Handle handle;
+
+  friend class detail::TaskPromise<T>;
+  friend class Scheduler;
+};
+
+/** @cond INTERNAL */
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+  return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+  return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+}  // namespace detail
+/** @endcond */
+
+/**
+ * @brief Scheduler to run coroutines on a fixed number of threads.
+ * @details Coroutines are resumed on a pool of worker threads. Timed waits are handled by a single timer thread which follows the central
+ * Clock, including its stepped mode. A coroutine that suspends does not occupy a thread, so that many concurrent behaviours can share
+ * few threads.
+ *
+ */
+class Scheduler
+{
+public:
+  /**
+   * @brief Reference to a scheduler that remains valid after the scheduler has been destroyed.
+   * @details Operations completed outside of the scheduler, such as service calls handled by an executor, resume their coroutine through
+   * a link instead of a raw pointer to the scheduler. Once the scheduler is being destroyed, resumptions through the link are discarded.
+   *
+   */
+  class Link
+  {
+  public:
+    explicit Link(Scheduler *scheduler) :
+      scheduler(scheduler)
+    {}
+
+    Link(const Link &) = delete;
+
+    /**
+     * @brief Resume a suspended coroutine on the linked scheduler.
+     *
+     * @param handle Handle of the coroutine.
+     * @return true When the coroutine has been scheduled.
+     * @return false When the scheduler has been destroyed and the coroutine must not be accessed anymore.
+     */
+    bool schedule(std::coroutine_handle<> handle);
+
+  private:
+    std::mutex mutex;
+    Scheduler *scheduler;
+
+    friend class Scheduler;
+  };
+
+  /**
+   * @brief Construct a new Scheduler object and start its threads.
+   *
+   * @param thread_count Number of worker threads. When zero, the number of concurrent threads supported by the system will be used.
+   * @param name Name of the worker threads.
+   * @param priority Scheduling priority of the worker threads.
+   */
+  explicit Scheduler(std::size_t thread_count = 1, const std::string &name = "scheduler", i32 priority = 1);
+  Scheduler(const Scheduler &) = delete;
+
+  /**
+   * @brief Stop all threads of the scheduler.
+   * Coroutines that have not finished yet are destroyed without being resumed.
+   *
+   */
+  ~Scheduler();
+
+  /**
+   * @brief Start a coroutine on the scheduler.
+   * The scheduler takes ownership of the coroutine. Arguments of the coroutine should be passed by value, as the coroutine might outlive
+   * the caller.
+   *
+   * @param task Coroutine to be started.
+   */
+  void spawn(Task<void> &&task);
+
+  /**
+   * @brief Wait until all coroutines started on the scheduler have finished.
+   * The first exception thrown by any of the coroutines will be rethrown.
+   *
+   */
+  void wait();
+
+  /**
+   * @brief Resume a suspended coroutine on one of the worker threads.
+   * Coroutines scheduled while the scheduler is being destroyed are discarded.
+   *
+   * @param handle Handle of the coroutine.
+   */
+  void schedule(std::coroutine_handle<> handle);
+
+  /**
+   * @brief Resume a suspended coroutine on one of the worker threads once the specified time has been reached.
+   *
+   * @param time Time at which the coroutine is to be resumed.
+   * @param handle Handle of the coroutine.
+   */
+  void scheduleAt(Clock::time_point time, std::coroutine_handle<> handle);
+
+  /**
+   * @brief Get the scheduler of the calling thread.
+   *
+   * @return Scheduler* Scheduler running the calling coroutine or nullptr when not called from within a worker thread.
+   */
+  [[nodiscard]] static Scheduler *current();
+
+  /**
+   * @brief Get the link to the scheduler.
+   *
+   * @return std::shared_ptr<Link> Link to be held by operations that resume coroutines of the scheduler from other threads.
+   */
+  [[nodiscard]] inline std::shared_ptr<Link> getLink() const
+  {
+    return link;
+  }
+
+private:
+  class Root;
+
+  struct TimerEntry
+  {
+    Clock::time_point time;
+    std::coroutine_handle<> handle;
+
+    bool operator>(const TimerEntry &rhs) const
+    {
+      return time > rhs.time;
+    }
+  };
+
+  static Root run(Scheduler &scheduler, Task<void> task);
+
+  void finish(std::coroutine_handle<> handle, std::exception_ptr exception);
+  void timerLoop(std::stop_token token);
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::unordered_set<void *> roots;
+  std::exception_ptr exception;
+
+  // Set under the mutex, but also read by queued resumptions without holding it.
+  std::atomic<bool> stopping;
+
+  std::mutex timer_mutex;
+  ConditionVariable timer_condition;
+  std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<>> timers;
+
+  const std::shared_ptr<Link> link;
+
+  std::unique_ptr<Executor> executor;
+  std::jthread timer_thread;
+
+  static thread_local Scheduler *current_scheduler;
+};
+
+/**
+ * @brief Awaitable to suspend the calling coroutine until the specified time has been reached.
+ *
+ */
+class SleepAwaiter
+{
+public:
+  explicit SleepAwaiter(Clock::time_point time) :
+    time(time)
+  {}
+
+  [[nodiscard]] bool await_ready() const
+  {
+    return time <= Clock::now();
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) const;
+
+  void await_resume() const noexcept {}
+
+private:
+  const Clock::time_point time;
+};
+
+/**
+ * @brief Suspend the calling coroutine until the specified timestamp.
+ * The coroutine must be run by a Scheduler.
+ *
+ * @param time Absolute timestamp until to sleep.
+ * @return SleepAwaiter Awaitable to be awaited by the coroutine.
+ */
+template <class Duration>
+SleepAwaiter sleepUntil(const std::chrono::time_point<Clock, Duration> &time)
+{
+  return SleepAwaiter(std::chrono::time_point_cast<Clock::duration>(time));
+}
+
+/**
+ * @brief Suspend the calling coroutine for the specified duration.
+ * The coroutine must be run by a Scheduler.
+ *
+ * @param duration Relative duration to sleep.
+ * @return SleepAwaiter Awaitable to be awaited by the coroutine.
+ */
+template <class Rep, class Period>
+SleepAwaiter sleepFor(const std::chrono::duration<Rep, Period> &duration)
+{
+  return SleepAwaiter(Clock::now() + std::chrono::duration_cast<Clock::duration>(duration));
+}
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
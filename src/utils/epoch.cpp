@@ -0,0 +1,27 @@
+/**
+ * @file epoch.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/utils/epoch.hpp>
+
+#include <atomic>
+
+inline namespace labrat {
+namespace lbot {
+inline namespace utils {
+
+std::size_t getEpochThreadIndex()
+{
+  static std::atomic<std::size_t> next_index = 0;
+  thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+
+  return index;
+}
+
+}  // namespace utils
+}  // namespace lbot
+}  // namespace labrat
@@ -0,0 +1,250 @@
+/**
+ * @file epoch.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+/**
+ * @brief Get a small index that is unique to the calling thread.
+ * Indices are handed out in the order in which threads first call this function.
+ *
+ * @return std::size_t Index of the calling thread.
+ */
+std::size_t getEpochThreadIndex();
+
+/**
+ * @brief Domain of epoch based reclamation.
+ * @details Shared data that is read within a critical section of the domain must not be reclaimed until synchronize() returns or until it
+ * has been reclaimed after being handed to retire(). Writers only wait for readers of their own domain. Each thread only writes to the slot
+ * it has been assigned to when entering or leaving a critical section, so that readers on different slots never contend with each other.
+ * Critical sections may be nested.
+ *
+ * @tparam SlotCount Number of slots among which the threads are distributed.
+ */
+template <std::size_t SlotCount>
+class EpochDomain
+{
+public:
+  /**
+   * @brief RAII guard of a read-side critical section of the domain.
+   *
+   */
+  class Guard
+  {
+  public:
+    /**
+     * @brief Enter a read-side critical section.
+     *
+     * @param domain Domain of the critical section.
+     */
+    explicit Guard(EpochDomain &domain) :
+      counter(domain.enter())
+    {}
+
+    /**
+     * @brief Enter a nested read-side critical section.
+     * The guard must be copied by the thread that owns it.
+     *
+     */
+    Guard(const Guard &rhs) :
+      counter(rhs.counter)
+    {
+      counter.fetch_add(1);
+    }
+
+    /**
+     * @brief Leave the read-side critical section.
+     *
+     */
+    ~Guard()
+    {
+      counter.fetch_sub(1);
+    }
+
+  private:
+    std::atomic<std::size_t> &counter;
+  };
+
+  EpochDomain() = default;
+  EpochDomain(const EpochDomain &) = delete;
+
+  /**
+   * @brief Destroy the domain and reclaim all retired objects.
+   * No reader may be within a critical section of the domain.
+   *
+   */
+  ~EpochDomain() = default;
+
+  /**
+   * @brief Wait until all read-side critical sections of the domain that have been entered before the call have been left.
+   * Data that has been unpublished before the call may be reclaimed afterwards. This must neither be called from within a critical section
+   * of the domain nor while holding a lock that is acquired within one.
+   *
+   */
+  void synchronize()
+  {
+    {
+      std::lock_guard guard(advance_mutex);
+      advance(true);
+    }
+
+    reclaim();
+  }
+
+  /**
+   * @brief Hand over an unpublished object to be deleted once no reader can access it anymore.
+   * This never waits for readers. Retired objects are reclaimed by later calls of retire() or synchronize() or when the domain is destroyed.
+   *
+   * @tparam T Type of the object.
+   * @param object Object to be deleted.
+   */
+  template <typename T>
+  void retire(std::unique_ptr<T> object)
+  {
+    {
+      std::lock_guard guard(retired_mutex);
+      retired.emplace_back(Retired{.epoch = epoch.load(), .object = std::shared_ptr<const void>(std::move(object))});
+    }
+
+    {
+      std::unique_lock lock(advance_mutex, std::try_to_lock);
+
+      if (lock.owns_lock()) {
+        advance(false);
+      }
+    }
+
+    reclaim();
+  }
+
+private:
+  struct alignas(64) Slot
+  {
+    // Number of readers within each of the two most recent epochs.
+    std::array<std::atomic<std::size_t>, 2> counters = {0, 0};
+  };
+
+  struct Retired
+  {
+    u64 epoch;
+    std::shared_ptr<const void> object;
+  };
+
+  std::atomic<std::size_t> &enter()
+  {
+    Slot &slot = slots[(SlotCount == 1) ? 0 : getEpochThreadIndex() % SlotCount];
+
+    while (true) {
+      const u64 local_epoch = epoch.load();
+      std::atomic<std::size_t> &counter = slot.counters[local_epoch & 1];
+
+      counter.fetch_add(1);
+
+      // A writer waiting for the counter might have missed the increment if the epoch has advanced in between.
+      if (epoch.load() == local_epoch) {
+        return counter;
+      }
+
+      counter.fetch_sub(1);
+    }
+  }
+
+  bool isDrained(u64 local_epoch) const
+  {
+    return std::all_of(slots.begin(), slots.end(), [local_epoch](const Slot &slot) -> bool {
+      return slot.counters[local_epoch & 1].load() == 0;
+    });
+  }
+
+  bool waitDrained(u64 local_epoch, bool blocking) const
+  {
+    while (!isDrained(local_epoch)) {
+      if (!blocking) {
+        return false;
+      }
+
+      std::this_thread::yield();
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Advance the epoch and wait for all readers of the previous epoch.
+   * The advance mutex must be held by the caller.
+   *
+   * @param blocking Whether to wait for readers. Otherwise the epoch is only advanced as far as possible.
+   */
+  void advance(bool blocking)
+  {
+    const u64 current = epoch.load();
+
+    // The counters of the previous epoch are reused by the next epoch, so its readers must have left first.
+    if (completed.load() + 1 < current) {
+      if (!waitDrained(current - 1, blocking)) {
+        return;
+      }
+
+      completed.store(current - 1);
+    }
+
+    epoch.store(current + 1);
+
+    if (waitDrained(current, blocking)) {
+      completed.store(current);
+    }
+  }
+
+  void reclaim()
+  {
+    const u64 local_completed = completed.load();
+
+    std::lock_guard guard(retired_mutex);
+
+    std::erase_if(retired, [local_completed](const Retired &entry) -> bool {
+      return entry.epoch <= local_completed;
+    });
+  }
+
+  std::atomic<u64> epoch = 1;
+  // All readers that have entered at or before this epoch have left.
+  std::atomic<u64> completed = 0;
+
+  std::array<Slot, SlotCount> slots;
+
+  std::mutex advance_mutex;
+
+  std::vector<Retired> retired;
+  std::mutex retired_mutex;
+};
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
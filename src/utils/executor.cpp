@@ -0,0 +1,268 @@
+/**
+ * @file executor.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/utils/executor.hpp>
+
+#include <algorithm>
+#include <utility>
+
+inline namespace labrat {
+namespace lbot {
+inline namespace utils {
+
+thread_local Executor *Executor::current_executor = nullptr;
+thread_local std::size_t Executor::current_index = 0;
+
+void Executor::Group::wait()
+{
+  join();
+
+  if (exception) {
+    std::rethrow_exception(std::exchange(exception, nullptr));
+  }
+}
+
+void Executor::Group::join()
+{
+  Executor *local_executor;
+
+  {
+    std::lock_guard guard(mutex);
+    local_executor = executor;
+  }
+
+  // Help executing pending tasks of this group. Other tasks are left to the workers, as they might take arbitrarily long. As all tasks of
+  // this group have already been submitted, the remaining tasks must be in progress once none of them is pending anymore.
+  while (local_executor != nullptr && local_executor->runPending(*this)) {
+    std::lock_guard guard(mutex);
+
+    if (pending == 0) {
+      return;
+    }
+  }
+
+  std::unique_lock lock(mutex);
+  condition.wait(lock, [this]() {
+    return pending == 0;
+  });
+}
+
+Executor::Executor(std::size_t thread_count, const std::string &name, i32 priority) :
+  next_worker(0),
+  pending_count(0),
+  sleeping_count(0)
+{
+  if (thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  workers.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    workers.emplace_back(std::make_unique<Worker>());
+  }
+
+  threads.reserve(thread_count);
+  for (std::size_t i = 0; i < thread_count; ++i) {
+    threads.emplace_back([this, name, priority, i](std::stop_token token) {
+      setup(name, priority);
+      workerLoop(token, i);
+    });
+  }
+}
+
+Executor::~Executor()
+{
+  // Help the workers to complete all pending tasks, as groups and futures might still wait for them.
+  while (pending_count.load() != 0) {
+    if (!runPending()) {
+      std::this_thread::yield();
+    }
+  }
+
+  for (std::jthread &thread : threads) {
+    thread.request_stop();
+  }
+
+  threads.clear();
+
+  // Tasks might have been submitted by the tasks that were still running.
+  while (runPending()) {}
+}
+
+void Executor::submit(Task &&task)
+{
+  push({.task = std::move(task), .group = nullptr});
+}
+
+void Executor::push(Entry &&entry)
+{
+  const std::size_t index =
+    (current_executor == this) ? current_index : (next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size());
+  Worker &worker = *workers[index];
+
+  pending_count.fetch_add(1);
+
+  {
+    std::lock_guard guard(worker.mutex);
+    worker.queue.emplace_back(std::move(entry));
+  }
+
+  // Only wake up a worker if any of them is sleeping.
+  if (sleeping_count.load() != 0) {
+    std::lock_guard guard(sleep_mutex);
+    sleep_condition.notify_one();
+  }
+}
+
+void Executor::submit(Group &group, Task &&task)
+{
+  {
+    std::lock_guard guard(group.mutex);
+    ++group.pending;
+    group.executor = this;
+  }
+
+  Task wrapper = [&group, task = std::move(task)]() {
+    std::exception_ptr exception;
+
+    try {
+      task();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    // Notify while holding the mutex, as the group may be destroyed as soon as the mutex is released.
+    std::lock_guard guard(group.mutex);
+    if (exception && !group.exception) {
+      group.exception = std::move(exception);
+    }
+
+    if (--group.pending == 0) {
+      group.condition.notify_all();
+    }
+  };
+
+  push({.task = std::move(wrapper), .group = &group});
+}
+
+bool Executor::runPending()
+{
+  Task task;
+
+  if (current_executor == this) {
+    if (!popTask(current_index, task) && !stealTask(current_index, task)) {
+      return false;
+    }
+  } else if (!stealTask(0, task)) {
+    return false;
+  }
+
+  task();
+
+  return true;
+}
+
+bool Executor::runPending(const Group &group)
+{
+  Task task;
+
+  if (!stealTask(group, task)) {
+    return false;
+  }
+
+  task();
+
+  return true;
+}
+
+void Executor::workerLoop(std::stop_token token, std::size_t index)
+{
+  current_executor = this;
+  current_index = index;
+
+  while (!token.stop_requested()) {
+    Task task;
+
+    if (popTask(index, task) || stealTask(index, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock lock(sleep_mutex);
+    sleeping_count.fetch_add(1);
+    sleep_condition.wait(lock, token, [this]() {
+      return pending_count.load() != 0;
+    });
+    sleeping_count.fetch_sub(1);
+  }
+}
+
+bool Executor::popTask(std::size_t index, Task &task)
+{
+  Worker &worker = *workers[index];
+  std::lock_guard guard(worker.mutex);
+
+  if (worker.queue.empty()) {
+    return false;
+  }
+
+  // Execute the most recently submitted task first, as its data is the most likely to still be cached.
+  task = std::move(worker.queue.back().task);
+  worker.queue.pop_back();
+  pending_count.fetch_sub(1);
+
+  return true;
+}
+
+bool Executor::stealTask(std::size_t index, Task &task)
+{
+  for (std::size_t i = 0; i < workers.size(); ++i) {
+    Worker &worker = *workers[(index + i) % workers.size()];
+    std::lock_guard guard(worker.mutex);
+
+    if (worker.queue.empty()) {
+      continue;
+    }
+
+    task = std::move(worker.queue.front().task);
+    worker.queue.pop_front();
+    pending_count.fetch_sub(1);
+
+    return true;
+  }
+
+  return false;
+}
+
+bool Executor::stealTask(const Group &group, Task &task)
+{
+  for (const std::unique_ptr<Worker> &worker : workers) {
+    std::lock_guard guard(worker->mutex);
+
+    const std::deque<Entry>::iterator iterator =
+      std::find_if(worker->queue.begin(), worker->queue.end(), [&group](const Entry &entry) {
+      return entry.group == &group;
+    });
+
+    if (iterator == worker->queue.end()) {
+      continue;
+    }
+
+    task = std::move(iterator->task);
+    worker->queue.erase(iterator);
+    pending_count.fetch_sub(1);
+
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace utils
+}  // namespace lbot
+}  // namespace labrat
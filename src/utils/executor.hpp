@@ -0,0 +1,178 @@
+/**
+ * @file executor.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/utils/thread.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+/**
+ * @brief Persistent pool of worker threads to execute tasks.
+ * @details Each worker owns a task queue. Tasks submitted from within a worker are queued on the queue of that worker, all other tasks are
+ * distributed among the workers. Idle workers steal tasks from the queues of other workers.
+ */
+class Executor : public Thread
+{
+public:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Group of tasks to be waited on collectively.
+   *
+   */
+  class Group
+  {
+  public:
+    Group() = default;
+    Group(const Group &) = delete;
+
+    /**
+     * @brief Wait for all tasks of the group to finish before destroying the group.
+     *
+     */
+    ~Group()
+    {
+      join();
+    }
+
+    /**
+     * @brief Wait for all tasks submitted to the group to finish.
+     * While waiting, the calling thread will help executing pending tasks of the group, but never tasks of other groups or ungrouped tasks.
+     * The first exception thrown by any of the tasks will be rethrown.
+     *
+     */
+    void wait();
+
+  private:
+    void join();
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::size_t pending = 0;
+    std::exception_ptr exception;
+
+    Executor *executor = nullptr;
+
+    friend class Executor;
+  };
+
+  /**
+   * @brief Construct a new Executor object and start its worker threads.
+   *
+   * @param thread_count Number of worker threads. When zero, the number of concurrent threads supported by the system will be used.
+   * @param name Name of the worker threads.
+   * @param priority Scheduling priority of the worker threads.
+   */
+  explicit Executor(std::size_t thread_count = 0, const std::string &name = "executor", i32 priority = 1);
+  Executor(const Executor &) = delete;
+
+  /**
+   * @brief Complete all pending tasks and stop all worker threads.
+   *
+   */
+  ~Executor();
+
+  /**
+   * @brief Submit a task to be executed by one of the workers.
+   *
+   * @param task Task to be executed.
+   */
+  void submit(Task &&task);
+
+  /**
+   * @brief Submit a task to be executed by one of the workers and add it to a group.
+   *
+   * @param group Group to add the task to.
+   * @param task Task to be executed.
+   */
+  void submit(Group &group, Task &&task);
+
+  /**
+   * @brief Execute a single pending task within the calling thread.
+   *
+   * @return true A task was executed.
+   * @return false No task was pending.
+   */
+  bool runPending();
+
+  /**
+   * @brief Get the number of worker threads.
+   *
+   * @return std::size_t Number of worker threads.
+   */
+  [[nodiscard]] inline std::size_t getThreadCount() const
+  {
+    return workers.size();
+  }
+
+private:
+  struct Entry
+  {
+    Task task;
+
+    // Group the task has been submitted to, if any.
+    const Group *group;
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Entry> queue;
+  };
+
+  void push(Entry &&entry);
+  bool runPending(const Group &group);
+
+  void workerLoop(std::stop_token token, std::size_t index);
+
+  bool popTask(std::size_t index, Task &task);
+  bool stealTask(std::size_t index, Task &task);
+  bool stealTask(const Group &group, Task &task);
+
+  std::vector<std::unique_ptr<Worker>> workers;
+
+  std::atomic<std::size_t> next_worker;
+  std::atomic<std::size_t> pending_count;
+  std::atomic<std::size_t> sleeping_count;
+
+  std::mutex sleep_mutex;
+  std::condition_variable_any sleep_condition;
+
+  std::vector<std::jthread> threads;
+
+  static thread_local Executor *current_executor;
+  static thread_local std::size_t current_index;
+};
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -0,0 +1,272 @@
+/**
+ * @file pool.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+/**
+ * @brief Pool of recycled memory blocks of a single size.
+ * @details The block size is determined by the first allocation. Allocations of any other size are forwarded to the global allocation
+ * functions. Use it through a PoolAllocator, which keeps the pool alive as long as any of its copies exists.
+ *
+ */
+class BlockPool
+{
+public:
+  /**
+   * @brief Create a new empty pool.
+   *
+   * @param max_size Maximum number of unused blocks kept by the pool.
+   * @return std::shared_ptr<BlockPool> The new pool.
+   */
+  static std::shared_ptr<BlockPool> create(std::size_t max_size)
+  {
+    return std::shared_ptr<BlockPool>(new BlockPool(max_size));
+  }
+
+  BlockPool(const BlockPool &) = delete;
+
+  /**
+   * @brief Destroy the pool and free all unused blocks.
+   *
+   */
+  ~BlockPool()
+  {
+    for (void *block : blocks) {
+      ::operator delete(block);
+    }
+  }
+
+  /**
+   * @brief Allocate a block of memory.
+   * The block is suitably aligned for any object with an alignment not exceeding the default alignment of the allocation functions.
+   *
+   * @param size Size of the block in bytes.
+   * @return void* The allocated block.
+   */
+  void *allocate(std::size_t size)
+  {
+    {
+      std::lock_guard guard(mutex);
+
+      if (block_size == 0) {
+        block_size = size;
+      }
+
+      if (size == block_size && !blocks.empty()) {
+        void *const block = blocks.back();
+        blocks.pop_back();
+
+        return block;
+      }
+    }
+
+    return ::operator new(size);
+  }
+
+  /**
+   * @brief Return a block of memory to the pool.
+   *
+   * @param block Block previously allocated from the pool.
+   * @param size Size of the block in bytes.
+   */
+  void deallocate(void *block, std::size_t size)
+  {
+    {
+      std::lock_guard guard(mutex);
+
+      if (size == block_size && blocks.size() < max_size) {
+        blocks.emplace_back(block);
+
+        return;
+      }
+    }
+
+    ::operator delete(block);
+  }
+
+private:
+  explicit BlockPool(std::size_t max_size) :
+    max_size(max_size)
+  {
+    blocks.reserve(max_size);
+  }
+
+  const std::size_t max_size;
+  std::size_t block_size = 0;
+
+  std::mutex mutex;
+  std::vector<void *> blocks;
+};
+
+/**
+ * @brief Allocator drawing its memory from a block pool.
+ * @details Hand it to allocator-aware standard types that allocate a single object at a time, such as the shared state of a std::promise.
+ * Over-aligned types are allocated with std::allocator instead.
+ *
+ * @tparam T Type of the allocated objects.
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  /**
+   * @brief Construct a new Pool Allocator object.
+   *
+   * @param pool Pool to draw the memory from.
+   */
+  explicit PoolAllocator(std::shared_ptr<BlockPool> pool) :
+    pool(std::move(pool))
+  {}
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &rhs) :
+    pool(rhs.pool)
+  {}
+
+  T *allocate(std::size_t count)
+  {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return std::allocator<T>().allocate(count);
+    } else {
+      return static_cast<T *>(pool->allocate(count * sizeof(T)));
+    }
+  }
+
+  void deallocate(T *pointer, std::size_t count)
+  {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      std::allocator<T>().deallocate(pointer, count);
+    } else {
+      pool->deallocate(pointer, count * sizeof(T));
+    }
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U> &rhs) const
+  {
+    return pool == rhs.pool;
+  }
+
+private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  std::shared_ptr<BlockPool> pool;
+};
+
+/**
+ * @brief Pool of recycled objects handed out as shared pointers.
+ * @details Once the last reference to an object has been released, the object is returned to the pool instead of being destroyed. Objects
+ * are handed out again without being reset, so that their internal allocations can be reused. The control blocks of the shared pointers are
+ * recycled through a block pool as well, so that acquiring an object does not allocate once the pool is warm. Acquiring and releasing an
+ * object each still lock two mutexes. The pool stays alive as long as any of its objects is referenced.
+ *
+ * @tparam T Type of the pooled objects.
+ */
+template <typename T>
+class ObjectPool : public std::enable_shared_from_this<ObjectPool<T>>
+{
+public:
+  /**
+   * @brief Create a new empty pool.
+   *
+   * @param max_size Maximum number of unused objects kept by the pool.
+   * @return std::shared_ptr<ObjectPool<T>> The new pool.
+   */
+  static std::shared_ptr<ObjectPool<T>> create(std::size_t max_size)
+  {
+    return std::shared_ptr<ObjectPool<T>>(new ObjectPool<T>(max_size));
+  }
+
+  ObjectPool(const ObjectPool &) = delete;
+
+  /**
+   * @brief Get an object of the pool.
+   * When no unused object is available, a new object is constructed from the supplied arguments. Otherwise, a previously used object is
+   * returned as is.
+   *
+   * @param args Arguments to construct a new object.
+   * @return std::shared_ptr<T> Object of the pool.
+   */
+  template <typename... Args>
+  std::shared_ptr<T> acquire(Args &&...args)
+  {
+    std::unique_ptr<T> object;
+
+    {
+      std::lock_guard guard(mutex);
+
+      if (!objects.empty()) {
+        object = std::move(objects.back());
+        objects.pop_back();
+      }
+    }
+
+    if (!object) {
+      object = std::make_unique<T>(std::forward<Args>(args)...);
+    }
+
+    auto deleter = [pool = this->shared_from_this()](T *pointer) {
+      pool->release(std::unique_ptr<T>(pointer));
+    };
+
+    return std::shared_ptr<T>(object.release(), std::move(deleter), PoolAllocator<T>(control_blocks));
+  }
+
+private:
+  explicit ObjectPool(std::size_t max_size) :
+    max_size(max_size),
+    control_blocks(BlockPool::create(max_size))
+  {
+    objects.reserve(max_size);
+  }
+
+  void release(std::unique_ptr<T> &&object)
+  {
+    std::lock_guard guard(mutex);
+
+    if (objects.size() < max_size) {
+      objects.emplace_back(std::move(object));
+    }
+  }
+
+  const std::size_t max_size;
+
+  // Memory of the control blocks, which all share the same size.
+  const std::shared_ptr<BlockPool> control_blocks;
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<T>> objects;
+};
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
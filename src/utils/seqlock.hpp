@@ -0,0 +1,125 @@
+/**
+ * @file seqlock.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+/** @cond INTERNAL */
+inline namespace utils {
+/** @endcond */
+
+/**
+ * @brief Sequence lock to share a trivially copyable value between a single writer and multiple readers.
+ * @details Neither the writer nor the readers will ever block. Readers retry their copy when it has been overlapped by a write operation.
+ * The value is stored as a sequence of atomic words, so that concurrent accesses are well defined.
+ *
+ * @tparam T Type of the stored value.
+ */
+template <typename T>
+class SeqLock
+{
+  static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>);
+
+public:
+  SeqLock() :
+    sequence(0)
+  {
+    for (std::atomic<u64> &word : data) {
+      word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  SeqLock(const SeqLock &) = delete;
+
+  /**
+   * @brief Store a new value.
+   * Only a single thread may store values at the same time.
+   *
+   * @param value Value to be stored.
+   */
+  void store(const T &value)
+  {
+    const std::array<std::byte, sizeof(T)> bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+
+    std::array<u64, word_count> words{};
+    std::memcpy(words.data(), bytes.data(), sizeof(T));
+
+    const u64 local_sequence = sequence.load(std::memory_order_relaxed);
+
+    // An odd sequence number marks a write operation in progress.
+    sequence.store(local_sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < word_count; ++i) {
+      data[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    sequence.store(local_sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Load the stored value.
+   * This call is guaranteed to not block.
+   *
+   * @return T Stored value.
+   */
+  T load() const
+  {
+    std::array<u64, word_count> words;
+
+    while (true) {
+      const u64 begin_sequence = sequence.load(std::memory_order_acquire);
+
+      if (begin_sequence & 1) {
+        continue;
+      }
+
+      for (std::size_t i = 0; i < word_count; ++i) {
+        words[i] = data[i].load(std::memory_order_relaxed);
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (sequence.load(std::memory_order_relaxed) == begin_sequence) {
+        break;
+      }
+    }
+
+    std::array<std::byte, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), words.data(), sizeof(T));
+
+    return std::bit_cast<T>(bytes);
+  }
+
+private:
+  static constexpr std::size_t word_count = (sizeof(T) + sizeof(u64) - 1) / sizeof(u64);
+
+  std::atomic<u64> sequence;
+  std::array<std::atomic<u64>, word_count> data;
+};
+
+/** @cond INTERNAL */
+}  // namespace utils
+/** @endcond */
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -0,0 +1,216 @@
+/**
+ * @file waitset.cpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#include <labrat/lbot/exception.hpp>
+#include <labrat/lbot/waitset.hpp>
+
+#include <algorithm>
+
+inline namespace labrat {
+namespace lbot {
+
+void Waitable::signal(bool flushed)
+{
+  // Avoid entering a critical section for the common case of an object that is neither attached to a wait set nor awaited. The sender has
+  // just committed its message with a sequentially consistent store, while the waiting side publishes itself with a sequentially
+  // consistent compare-exchange in attach() or addWaiter() and only then checks for data. As the loads below are sequentially consistent
+  // as well, they cannot be reordered before the commit, so that either this sees the waiter or the waiter sees the message. Unlike a
+  // fence, such loads are plain loads on most architectures.
+  if (wait_set.load() == nullptr && waiter.load() == nullptr) {
+    return;
+  }
+
+  const EpochDomain<1>::Guard guard(epoch_domain);
+
+  Waiter *const local_waiter = waiter.exchange(nullptr);
+
+  if (local_waiter != nullptr) {
+    local_waiter->function(*local_waiter);
+  }
+
+  WaitSet *const local_wait_set = wait_set.load();
+
+  if (local_wait_set == nullptr) {
+    return;
+  }
+
+  if (flushed) {
+    flush_pending.store(true);
+  }
+
+  local_wait_set->notify();
+}
+
+void Waitable::leaveWaitSet()
+{
+  WaitSet *const local_wait_set = wait_set.load();
+
+  if (local_wait_set != nullptr) {
+    local_wait_set->detach(*this);
+  }
+}
+
+void Waitable::addWaiter(Waiter &new_waiter)
+{
+  Waiter *expected = nullptr;
+
+  if (!waiter.compare_exchange_strong(expected, &new_waiter)) {
+    throw BadUsageException("The receiver is already awaited by another coroutine.");
+  }
+}
+
+bool Waitable::removeWaiter(Waiter &old_waiter)
+{
+  Waiter *expected = &old_waiter;
+
+  if (waiter.compare_exchange_strong(expected, nullptr)) {
+    return true;
+  }
+
+  // Wait for a concurrent signal to finish notifying the waiter.
+  synchronizeSignals();
+
+  return false;
+}
+
+void Waitable::synchronizeSignals()
+{
+  epoch_domain.synchronize();
+}
+
+WaitSet::WaitSet() :
+  sequence(0),
+  waiter_count(0)
+{}
+
+WaitSet::~WaitSet()
+{
+  std::lock_guard guard(member_mutex);
+
+  for (Waitable *object : members) {
+    object->wait_set.store(nullptr);
+
+    // Signals never acquire the mutex, so that they can be waited for while it is held.
+    object->synchronizeSignals();
+  }
+
+  members.clear();
+}
+
+void WaitSet::attach(Waitable &object)
+{
+  std::lock_guard guard(member_mutex);
+
+  WaitSet *expected = nullptr;
+
+  if (!object.wait_set.compare_exchange_strong(expected, this)) {
+    throw BadUsageException("The receiver is already attached to a wait set.");
+  }
+
+  object.flush_pending.store(false);
+  members.emplace_back(&object);
+}
+
+void WaitSet::detach(Waitable &object)
+{
+  detachInternal(object);
+
+  // Wait for all senders that might still be signaling the wait set through the object.
+  object.synchronizeSignals();
+}
+
+void WaitSet::detachInternal(Waitable &object)
+{
+  std::lock_guard guard(member_mutex);
+
+  const std::vector<Waitable *>::iterator iterator = std::find(members.begin(), members.end(), &object);
+
+  if (iterator == members.end()) {
+    throw BadUsageException("The receiver is not attached to this wait set.");
+  }
+
+  members.erase(iterator);
+  object.wait_set.store(nullptr);
+}
+
+std::size_t WaitSet::size() const
+{
+  std::lock_guard guard(member_mutex);
+
+  return members.size();
+}
+
+std::vector<Waitable *> WaitSet::wait(const std::chrono::nanoseconds &timeout_duration)
+{
+  std::vector<Waitable *> result;
+  wait(result, timeout_duration);
+
+  return result;
+}
+
+void WaitSet::wait(std::vector<Waitable *> &result, const std::chrono::nanoseconds &timeout_duration)
+{
+  const std::chrono::steady_clock::time_point timeout_point = std::chrono::steady_clock::now() + timeout_duration;
+
+  result.clear();
+
+  while (true) {
+    // Load the sequence before checking the members, so that no update in between is missed.
+    const u64 local_sequence = sequence.load();
+
+    {
+      std::lock_guard guard(member_mutex);
+
+      for (Waitable *object : members) {
+        const bool flushed = object->flush_pending.exchange(false);
+
+        if (flushed || object->has_update(*object)) {
+          result.emplace_back(object);
+        }
+      }
+    }
+
+    if (!result.empty()) {
+      return;
+    }
+
+    std::unique_lock lock(condition_mutex);
+    waiter_count.fetch_add(1);
+
+    const auto predicate = [this, local_sequence]() -> bool {
+      return sequence.load() != local_sequence;
+    };
+
+    bool success = true;
+
+    if (timeout_duration == std::chrono::nanoseconds::zero()) {
+      condition.wait(lock, predicate);
+    } else {
+      success = condition.wait_until(lock, timeout_point, predicate);
+    }
+
+    waiter_count.fetch_sub(1);
+
+    if (!success) {
+      return;
+    }
+  }
+}
+
+void WaitSet::notify()
+{
+  sequence.fetch_add(1);
+
+  if (waiter_count.load() != 0) {
+    std::lock_guard guard(condition_mutex);
+    condition.notify_all();
+  }
+}
+
+}  // namespace lbot
+}  // namespace labrat
@@ -0,0 +1,217 @@
+/**
+ * @file waitset.hpp
+ * @author Max Yvon Zimmermann
+ *
+ * @copyright GNU Lesser General Public License v2.1 or later (LGPL-2.1-or-later)
+ *
+ */
+
+#pragma once
+
+#include <labrat/lbot/base.hpp>
+#include <labrat/lbot/utils/epoch.hpp>
+#include <labrat/lbot/utils/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+/** @cond INTERNAL */
+inline namespace labrat {
+/** @endcond */
+namespace lbot {
+
+class WaitSet;
+
+/**
+ * @brief Base class of all objects that can be attached to a wait set or be awaited by a single waiter.
+ *
+ */
+class Waitable
+{
+protected:
+  using UpdateFunction = bool (*)(const Waitable &object);
+
+  /**
+   * @brief One-shot notification to be performed on the next signal of the object.
+   *
+   */
+  struct Waiter
+  {
+    using Function = void (*)(Waiter &waiter);
+
+    Function function;
+  };
+
+  /**
+   * @brief Construct a new Waitable object.
+   *
+   * @param has_update Function to check whether the object has unread data available.
+   */
+  explicit Waitable(UpdateFunction has_update) :
+    has_update(has_update)
+  {}
+
+  Waitable(const Waitable &) = delete;
+
+  ~Waitable() = default;
+
+  /**
+   * @brief Wake up the wait set the object is attached to, if any.
+   *
+   * @param flushed Whether the object has been flushed. The object will then be reported once even if it has no unread data.
+   */
+  void signal(bool flushed = false);
+
+  /**
+   * @brief Detach the object from its wait set, if any.
+   * This must be called by the destructor of the derived class, as the wait set might access the object until this returns.
+   *
+   */
+  void leaveWaitSet();
+
+  /**
+   * @brief Register a waiter to be notified on the next signal of the object.
+   * The caller must check for updates after this returns, as a preceding signal will not be reported to the waiter.
+   *
+   * @param waiter Waiter to be registered.
+   * @throw BadUsageException When another waiter is already registered.
+   */
+  void addWaiter(Waiter &waiter);
+
+  /**
+   * @brief Unregister a waiter that has not been notified yet.
+   * Once this returns, the waiter will no longer be accessed.
+   *
+   * @param waiter Waiter to be unregistered.
+   * @return true When the waiter has been unregistered.
+   * @return false When the waiter has already been notified.
+   */
+  bool removeWaiter(Waiter &waiter);
+
+  /**
+   * @brief Wait for all concurrent signals of the object to finish.
+   * This must not be called from within a waiter of the object.
+   *
+   */
+  void synchronizeSignals();
+
+private:
+  friend class WaitSet;
+
+  const UpdateFunction has_update;
+
+  std::atomic<WaitSet *> wait_set = nullptr;
+  std::atomic<bool> flush_pending = false;
+
+  std::atomic<Waiter *> waiter = nullptr;
+
+  // Objects are usually signalled by a single sender, so that a single slot suffices.
+  EpochDomain<1> epoch_domain;
+};
+
+/**
+ * @brief Set of receivers that can be waited on from a single thread.
+ * @details All attached receivers share a single condition variable, so that a node consuming many topics does not require a blocking
+ * thread per receiver. Each receiver can only be attached to one wait set at a time. A wait set must not be destroyed while another thread
+ * waits on it.
+ *
+ */
+class WaitSet final
+{
+public:
+  /**
+   * @brief Construct a new empty Wait Set object.
+   *
+   */
+  WaitSet();
+
+  WaitSet(const WaitSet &) = delete;
+
+  /**
+   * @brief Destroy the Wait Set object and detach all remaining receivers.
+   *
+   */
+  ~WaitSet();
+
+  /**
+   * @brief Attach a receiver to the wait set.
+   *
+   * @param object Receiver to be attached.
+   * @throw BadUsageException When the receiver is already attached to a wait set.
+   */
+  void attach(Waitable &object);
+
+  /**
+   * @brief Detach a receiver from the wait set.
+   * Once this returns, the receiver no longer accesses the wait set.
+   *
+   * @param object Receiver to be detached.
+   * @throw BadUsageException When the receiver is not attached to this wait set.
+   */
+  void detach(Waitable &object);
+
+  /**
+   * @brief Get the number of attached receivers.
+   *
+   * @return std::size_t Number of attached receivers.
+   */
+  [[nodiscard]] std::size_t size() const;
+
+  /**
+   * @brief Wait until at least one attached receiver has unread data available or has been flushed.
+   *
+   * @param timeout_duration Duration of the timeout. A duration of zero will wait indefinitely.
+   * @return std::vector<Waitable *> Receivers with unread data available. It is empty when the timeout has been exceeded.
+   */
+  std::vector<Waitable *> wait(const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero());
+
+  template <typename R, typename P>
+  std::vector<Waitable *> wait(const std::chrono::duration<R, P> &timeout_duration)
+  {
+    return wait(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
+  }
+
+  /**
+   * @brief Wait until at least one attached receiver has unread data available or has been flushed.
+   * The result is written to a vector owned by the caller, so that its allocation can be reused across calls.
+   *
+   * @param result Vector to be filled with the receivers with unread data available. It is cleared first and remains empty when the
+   * timeout has been exceeded.
+   * @param timeout_duration Duration of the timeout. A duration of zero will wait indefinitely.
+   */
+  void wait(std::vector<Waitable *> &result, const std::chrono::nanoseconds &timeout_duration = std::chrono::nanoseconds::zero());
+
+  template <typename R, typename P>
+  void wait(std::vector<Waitable *> &result, const std::chrono::duration<R, P> &timeout_duration)
+  {
+    wait(result, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout_duration));
+  }
+
+private:
+  friend class Waitable;
+
+  void detachInternal(Waitable &object);
+
+  /**
+   * @brief Wake up the thread waiting on the wait set.
+   * The mutex is only acquired when there is a waiting thread.
+   *
+   */
+  void notify();
+
+  std::vector<Waitable *> members;
+  mutable std::mutex member_mutex;
+
+  std::atomic<u64> sequence;
+  std::atomic<std::size_t> waiter_count;
+  std::mutex condition_mutex;
+  std::condition_variable condition;
+};
+
+}  // namespace lbot
+/** @cond INTERNAL */
+}  // namespace labrat
+/** @endcond */
@@ -13,6 +13,7 @@ class LbotTestConan(ConanFile):
     def build_requirements(self):
         self.tool_requires("cmake/[>=3.22.0]")
         self.test_requires("gtest/[>=1.14.0]")
+        self.test_requires("benchmark/[>=1.8.0]")
 
     def layout(self):
         cmake_layout(self)
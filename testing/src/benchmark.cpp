@@ -0,0 +1,562 @@
+#include <labrat/lbot/exception.hpp>
+#include <labrat/lbot/logger.hpp>
+#include <labrat/lbot/manager.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <helper.hpp>
+
+inline namespace labrat {
+namespace lbot::test {
+
+class NullPlugin : public lbot::Plugin
+{
+public:
+  NullPlugin() = default;
+
+  void messageCallback(const lbot::MessageInfo &)
+  {}
+};
+
+static void nullCallback(const TestContainer &)
+{}
+
+static void nullFlatbufferCallback(const Message<TestFlatbuffer> &)
+{}
+
+/**
+ * @brief Message sizes from 8 B up to 10 MB.
+ *
+ */
+static void messageSizes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->ArgName("size");
+
+  for (i64 size : {8, 64, 512, 4096, 32768, 262144, 2097152, 10000000}) {
+    benchmark->Arg(size);
+  }
+}
+
+static void putReceivers(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  const i64 receiver_count = state.range(0);
+  const bool is_const = state.range(1);
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Sender<TestFlatbuffer>::Ptr sender = node_a->addSender<TestFlatbuffer>("main");
+  std::vector<Node::Receiver<TestFlatbuffer>::Ptr> receivers;
+  std::vector<Node::Receiver<Message<const TestFlatbuffer>>::Ptr> const_receivers;
+
+  // Const receivers share a single copy of the message, which they only get to see through their callbacks.
+  for (i64 i = 0; i < receiver_count; ++i) {
+    if (is_const) {
+      const_receivers.emplace_back(node_b->addReceiver<Message<const TestFlatbuffer>>("main"));
+      const_receivers.back()->setCallback(&nullFlatbufferCallback);
+    } else {
+      receivers.emplace_back(node_b->addReceiver<TestFlatbuffer>("main"));
+    }
+  }
+
+  Message<TestFlatbuffer> message;
+  message.buffer.resize(8);
+
+  for (auto _ : state) {
+    sender->put(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  sender.reset();
+  receivers.clear();
+  const_receivers.clear();
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(putReceivers)->ArgNames({"receivers", "const"})->ArgsProduct({{0, 1, 4, 16}, {0, 1}});
+
+static void putSize(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  TestContainer message;
+  message.buffer.resize(state.range(0));
+
+  for (auto _ : state) {
+    node_a->sender->put(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(putSize)->Apply(messageSizes);
+
+static void putMove(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  TestContainer message;
+
+  // The buffer is moved onto the topic, so it has to be recreated for every message. Compare with putSize plus the allocation.
+  for (auto _ : state) {
+    message.buffer.resize(state.range(0));
+
+    node_a->sender->put(std::move(message));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(putMove)->Apply(messageSizes);
+
+static void callback(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  node_b->receiver->setCallback(&nullCallback, state.range(0) ? lbot::ExecutionPolicy::parallel : lbot::ExecutionPolicy::serial);
+
+  TestContainer message;
+  message.buffer.resize(8);
+
+  for (auto _ : state) {
+    node_a->sender->put(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(callback)->ArgName("parallel")->Arg(0)->Arg(1);
+
+static void trace(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<NullPlugin> plugin(manager->addPlugin<NullPlugin>("plugin"));
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node", "main", ""));
+
+  TestContainer message;
+  message.buffer.resize(state.range(0));
+
+  for (auto _ : state) {
+    node->sender->trace(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+
+  node = std::shared_ptr<TestNode>();
+  manager->removeNode("node");
+  plugin = std::shared_ptr<NullPlugin>();
+  manager->removePlugin("plugin");
+}
+
+BENCHMARK(trace)->Apply(messageSizes);
+
+/**
+ * @brief Placement of the sending and the receiving thread relative to each other.
+ *
+ */
+enum class Placement : i64
+{
+  /** Both threads share the same logical CPU. */
+  same_core,
+  /** The threads run on two hardware threads of the same physical core. */
+  sibling,
+  /** The threads run on CPUs of different sockets. */
+  cross_socket,
+};
+
+/**
+ * @brief Logical CPU and its location within the system.
+ *
+ */
+struct Cpu
+{
+  int id;
+  int core_id;
+  int package_id;
+};
+
+static int readTopology(int cpu, const std::string &name)
+{
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+
+  int result = -1;
+  file >> result;
+
+  return result;
+}
+
+/**
+ * @brief Select a CPU for the sending and the receiving thread.
+ *
+ * @param placement Requested placement of the threads.
+ * @return std::optional<std::pair<int, int>> CPU of the sending and the receiving thread or std::nullopt when the system does not
+ * provide CPUs with the requested placement.
+ */
+static std::optional<std::pair<int, int>> selectCpus(Placement placement)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return std::nullopt;
+  }
+
+  std::vector<Cpu> cpus;
+
+  for (int i = 0; i < CPU_SETSIZE; ++i) {
+    if (CPU_ISSET(i, &set)) {
+      cpus.emplace_back(Cpu{.id = i, .core_id = readTopology(i, "core_id"), .package_id = readTopology(i, "physical_package_id")});
+    }
+  }
+
+  if (cpus.empty()) {
+    return std::nullopt;
+  }
+
+  for (const Cpu &first : cpus) {
+    for (const Cpu &second : cpus) {
+      switch (placement) {
+        case Placement::same_core: {
+          return std::make_pair(first.id, first.id);
+        }
+
+        case Placement::sibling: {
+          if (first.id != second.id && first.package_id == second.package_id && first.core_id == second.core_id) {
+            return std::make_pair(first.id, second.id);
+          }
+          break;
+        }
+
+        case Placement::cross_socket: {
+          if (first.package_id != second.package_id) {
+            return std::make_pair(first.id, second.id);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+static void pinThread(int cpu)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static i64 steadyNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Latency samples of the messages received during a benchmark.
+ *
+ */
+class LatencyProbe
+{
+public:
+  /**
+   * @brief Record the latency of a received message.
+   * Messages without a send time are used to wake up the receiver and are not recorded.
+   *
+   * @param message Received message holding its send time in the integral field.
+   */
+  void record(const TestContainer &message)
+  {
+    if (message.integral_field != 0) {
+      samples.emplace_back(steadyNow() - static_cast<i64>(message.integral_field));
+    }
+
+    received_count.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Wait until the supplied number of messages has been received.
+   *
+   * @param count Number of messages.
+   */
+  void wait(u64 count) const
+  {
+    while (received_count.load(std::memory_order_acquire) < count) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief Report the percentiles of the recorded latencies as counters of the benchmark.
+   *
+   * @param state State of the benchmark.
+   */
+  void report(benchmark::State &state)
+  {
+    if (samples.empty()) {
+      return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const auto percentile = [this](double fraction) -> double {
+      return samples[std::min<std::size_t>(fraction * samples.size(), samples.size() - 1)];
+    };
+
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p99.9_ns"] = percentile(0.999);
+    state.counters["max_ns"] = samples.back();
+  }
+
+private:
+  std::vector<i64> samples;
+  std::atomic<u64> received_count = 0;
+};
+
+static void latencyCallback(const TestContainer &message, LatencyProbe *probe)
+{
+  probe->record(message);
+}
+
+/**
+ * @brief Threads sending messages as fast as possible to load the system while latencies are measured.
+ *
+ */
+class LoadGenerator
+{
+public:
+  LoadGenerator(lbot::Manager &manager, std::size_t thread_count) :
+    manager(manager)
+  {
+    if (thread_count == 0) {
+      return;
+    }
+
+    node = manager.addNode<TestNode>("load");
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      const std::string topic = "/load/" + std::to_string(i);
+
+      senders.emplace_back(node->addSender<TestMessageConv>(topic));
+      receivers.emplace_back(node->addReceiver<TestMessageConv>(topic));
+    }
+
+    for (Node::Sender<TestMessageConv>::Ptr &sender : senders) {
+      threads.emplace_back([this, &sender]() {
+        TestContainer message;
+        message.buffer.resize(64);
+
+        while (!exit_flag.load(std::memory_order_relaxed)) {
+          sender->put(message);
+        }
+      });
+    }
+  }
+
+  ~LoadGenerator()
+  {
+    exit_flag.store(true);
+
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+
+    if (node) {
+      senders.clear();
+      receivers.clear();
+      node = std::shared_ptr<TestNode>();
+      manager.removeNode("load");
+    }
+  }
+
+private:
+  lbot::Manager &manager;
+  std::shared_ptr<TestNode> node;
+  std::vector<Node::Sender<TestMessageConv>::Ptr> senders;
+  std::vector<Node::Receiver<TestMessageConv>::Ptr> receivers;
+  std::vector<std::thread> threads;
+  std::atomic<bool> exit_flag = false;
+};
+
+/**
+ * @brief Send messages one at a time and wait until they have been received.
+ * Between two messages, the receiver is given time to go back to sleep, so that every sample includes a wakeup.
+ *
+ */
+static void measureLatency(benchmark::State &state, Node::Sender<TestMessageConv> &sender, LatencyProbe &probe)
+{
+  TestContainer message;
+  message.buffer.resize(8);
+
+  // Wake up the receiver for the first time.
+  sender.put(message);
+  probe.wait(1);
+
+  u64 count = 1;
+
+  for (auto _ : state) {
+    message.integral_field = steadyNow();
+    sender.put(message);
+    probe.wait(++count);
+
+    state.PauseTiming();
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    state.ResumeTiming();
+  }
+
+  probe.report(state);
+}
+
+static void nextLatency(benchmark::State &state)
+{
+  const std::optional<std::pair<int, int>> cpus = selectCpus(static_cast<Placement>(state.range(0)));
+
+  if (!cpus) {
+    state.SkipWithError("The system does not provide CPUs with the requested placement.");
+    return;
+  }
+
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", ""));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "", "main"));
+
+  LatencyProbe probe;
+  std::atomic<bool> exit_flag = false;
+
+  std::thread thread([&]() {
+    pinThread(cpus->second);
+
+    while (!exit_flag.load()) {
+      try {
+        probe.record(node_b->receiver->next(std::chrono::milliseconds(100)));
+      } catch (TopicNoDataAvailableException &) {
+      } catch (TopicTimeoutException &) {
+      }
+    }
+  });
+
+  cpu_set_t affinity;
+  pthread_getaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+  pinThread(cpus->first);
+
+  {
+    LoadGenerator load(*manager, state.range(1) ? std::thread::hardware_concurrency() : 0);
+
+    measureLatency(state, *node_a->sender, probe);
+  }
+
+  pthread_setaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+
+  exit_flag.store(true);
+  thread.join();
+
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(nextLatency)->ArgNames({"placement", "load"})->ArgsProduct({{0, 1, 2}, {0, 1}})->UseRealTime();
+
+static void callbackLatency(benchmark::State &state)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", ""));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "", "main"));
+
+  // The thread running the callback is chosen by the execution policy, so it cannot be placed.
+  LatencyProbe probe;
+  node_b->receiver->setCallback(&latencyCallback, &probe, static_cast<lbot::ExecutionPolicy>(state.range(0)));
+
+  {
+    LoadGenerator load(*manager, state.range(1) ? std::thread::hardware_concurrency() : 0);
+
+    measureLatency(state, *node_a->sender, probe);
+  }
+
+  node_a = std::shared_ptr<TestNode>();
+  manager->removeNode("node_a");
+  node_b = std::shared_ptr<TestNode>();
+  manager->removeNode("node_b");
+}
+
+BENCHMARK(callbackLatency)->ArgNames({"policy", "load"})->ArgsProduct({{0, 1, 2}, {0, 1}})->UseRealTime();
+
+}  // namespace lbot::test
+}  // namespace labrat
+
+int main(int argc, char **argv)
+{
+  // Results are written as JSON unless another format is requested, so that they can be compared across releases.
+  std::vector<char *> arguments(argv, argv + argc);
+  std::string format = "--benchmark_format=json";
+  arguments.insert(arguments.begin() + 1, format.data());
+
+  int argument_count = arguments.size();
+  benchmark::Initialize(&argument_count, arguments.data());
+
+  if (benchmark::ReportUnrecognizedArguments(argument_count, arguments.data())) {
+    return 1;
+  }
+
+  lbot::Logger::setLogLevel(lbot::Logger::Verbosity::warning);
+
+  // The manager is kept alive while all benchmarks are run, as it cannot be created twice.
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
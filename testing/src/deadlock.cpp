@@ -14,6 +14,27 @@ namespace lbot::test {
 class DeadlockTest : public LbotTest
 {};
 
+struct TopologyData
+{
+  TestNode *node = nullptr;
+  Node::Receiver<TestMessageConv>::Ptr receiver;
+  std::size_t callback_count = 0;
+};
+
+static void topologyCallback(const TestContainer & /*message*/, TopologyData *data)
+{
+  // Adding a receiver to the topic of the callback must not wait for the sender.
+  if (!data->receiver) {
+    data->receiver = data->node->addReceiver<TestMessageConv>("/topology/a");
+  }
+
+  // Removing a receiver of another topic must not wait for the sender either.
+  Node::Receiver<TestMessageConv>::Ptr receiver = data->node->addReceiver<TestMessageConv>("/topology/b");
+  receiver.reset();
+
+  ++data->callback_count;
+}
+
 TEST_F(DeadlockTest, next)
 {
   labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
@@ -50,5 +71,38 @@ TEST_F(DeadlockTest, next)
   ASSERT_TRUE(exit_flag.test());
 }
 
+TEST_F(DeadlockTest, callback_topology)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  for (lbot::ExecutionPolicy policy : {lbot::ExecutionPolicy::serial, lbot::ExecutionPolicy::parallel, lbot::ExecutionPolicy::pooled}) {
+    std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node", "/topology/a", "/topology/a"));
+
+    TopologyData data;
+    data.node = node.get();
+    node->receiver->setCallback(&topologyCallback, &data, policy);
+
+    std::atomic_flag exit_flag;
+
+    std::thread([&]() {
+      TestContainer message;
+      message.integral_field = 10;
+      message.float_field = 5.0;
+
+      node->sender->put(message);
+      node->sender->put(message);
+      exit_flag.test_and_set();
+    }).detach();
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    ASSERT_TRUE(exit_flag.test());
+    ASSERT_EQ(data.callback_count, 2);
+
+    data.receiver.reset();
+    node.reset();
+    ASSERT_NO_THROW(manager->removeNode("node"));
+  }
+}
+
 }  // namespace lbot::test
 }  // namespace labrat
@@ -4,6 +4,7 @@
 #include <labrat/lbot/plugin.hpp>
 
 #include <atomic>
+#include <mutex>
 
 #include <gtest/gtest.h>
 
@@ -147,6 +148,37 @@ static_assert(can_move_from<TestMessageConvPtr>);
 static_assert(can_convert_to<TestMessageConvPtr>);
 static_assert(can_move_to<TestMessageConvPtr>);
 
+struct TestTrivialContainer
+{
+  u64 integral_field = 0;
+  double float_field = 0;
+
+  bool operator==(const TestTrivialContainer &rhs) const = default;
+};
+
+class TestMessageTrivial : public lbot::MessageBase<TestFlatbuffer, TestTrivialContainer>
+{
+public:
+  using Message = lbot::MessageBase<TestFlatbuffer, TestTrivialContainer>;
+
+  static void convertFrom(const TestTrivialContainer &source, Message &destination)
+  {
+    destination.integral_field = source.integral_field;
+    destination.float_field = source.float_field;
+  }
+
+  static void convertTo(const Message &source, TestTrivialContainer &destination)
+  {
+    destination.integral_field = source.integral_field;
+    destination.float_field = source.float_field;
+  }
+};
+
+static_assert(is_message<TestMessageTrivial>);
+static_assert(is_trivial_message<TestMessageTrivial>);
+static_assert(!is_trivial_message<TestMessageConv>);
+static_assert(!is_trivial_message<TestConstMessage>);
+
 class TestUniqueNode : public lbot::UniqueNode
 {
 public:
@@ -182,6 +214,8 @@ public:
   using lbot::Node::addReceiver;
   using lbot::Node::addSender;
   using lbot::Node::addServer;
+  using lbot::Node::addSynchronizer;
+  using lbot::Node::addViewReceiver;
   using lbot::Node::getLogger;
 
   Sender<TestMessageConv>::Ptr sender;
@@ -207,5 +241,38 @@ public:
   TestPlugin() = default;
 };
 
+class TestMessagePlugin : public lbot::Plugin
+{
+public:
+  TestMessagePlugin() = default;
+
+  void messageCallback(const lbot::MessageInfo &info)
+  {
+    if (info.serialized_message.size() != 0) {
+      ++message_count;
+    }
+  }
+
+  std::atomic<u64> message_count = 0;
+};
+
+class TestGatedPlugin : public lbot::Plugin
+{
+public:
+  TestGatedPlugin() = default;
+
+  void messageCallback(const lbot::MessageInfo &info)
+  {
+    std::lock_guard guard(gate);
+
+    if (info.serialized_message.size() != 0) {
+      ++message_count;
+    }
+  }
+
+  std::mutex gate;
+  std::atomic<u64> message_count = 0;
+};
+
 }  // namespace lbot::test
 }  // namespace labrat
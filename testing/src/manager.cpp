@@ -1,5 +1,13 @@
+#include <labrat/lbot/config.hpp>
 #include <labrat/lbot/manager.hpp>
+#include <labrat/lbot/msg/latency_statistics.hpp>
+#include <labrat/lbot/msg/topic_statistics.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -12,6 +20,42 @@ namespace lbot::test {
 class ManagerTest : public LbotTest
 {};
 
+class TestSlowPlugin : public lbot::Plugin
+{
+public:
+  explicit TestSlowPlugin(std::atomic<u64> &message_count) :
+    message_count(message_count)
+  {}
+
+  void messageCallback(const lbot::MessageInfo & /*info*/)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++message_count;
+  }
+
+  std::atomic<u64> &message_count;
+};
+
+#ifdef LBOT_ENABLE_TRACING
+struct TracingData
+{
+  Node::Sender<TestFlatbuffer> *sender;
+  lbot::TraceContext forwarded;
+  lbot::TraceContext received;
+};
+
+static void forwardCallback(const Message<TestFlatbuffer> &message, TracingData *data)
+{
+  data->forwarded = message.getTraceContext();
+  data->sender->put(message);
+}
+
+static void receiveCallback(const Message<TestFlatbuffer> &message, TracingData *data)
+{
+  data->received = message.getTraceContext();
+}
+#endif
+
 TEST_F(ManagerTest, get)
 {
   {
@@ -78,5 +122,331 @@ TEST_F(ManagerTest, shared_plugin)
   ASSERT_NO_THROW(manager->removePlugin("plugin_b"));
 }
 
+TEST_F(ManagerTest, plugin_filter)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  lbot::Filter filter_b;
+  filter_b.whitelist("other");
+
+  std::shared_ptr<TestMessagePlugin> plugin_a(manager->addPlugin<TestMessagePlugin>("plugin_a"));
+  std::shared_ptr<TestMessagePlugin> plugin_b(manager->addPlugin<TestMessagePlugin>("plugin_b", filter_b));
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node", "main", "void"));
+
+  TestContainer message;
+  message.integral_field = 10;
+
+  node->sender->put(message);
+
+  ASSERT_EQ(plugin_a->message_count, 1);
+  ASSERT_EQ(plugin_b->message_count, 0);
+
+  lbot::Filter filter_c;
+  filter_c.whitelist("main");
+
+  std::shared_ptr<TestMessagePlugin> plugin_c(manager->addPlugin<TestMessagePlugin>("plugin_c", filter_c));
+
+  node->sender->put(message);
+
+  ASSERT_EQ(plugin_a->message_count, 2);
+  ASSERT_EQ(plugin_b->message_count, 0);
+  ASSERT_EQ(plugin_c->message_count, 1);
+
+  plugin_a = std::shared_ptr<TestMessagePlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin_a"));
+
+  node->sender->trace(message);
+
+  ASSERT_EQ(plugin_c->message_count, 2);
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+  plugin_b = std::shared_ptr<TestMessagePlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin_b"));
+  plugin_c = std::shared_ptr<TestMessagePlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin_c"));
+}
+
+TEST_F(ManagerTest, plugin_pattern)
+{
+  lbot::Filter filter_a;
+  filter_a.whitelistPattern("/camera/**");
+  filter_a.whitelistPattern("/sensor/*/raw");
+  filter_a.whitelistPattern("/imu?");
+
+  ASSERT_TRUE(filter_a.check(std::string("/camera/front")));
+  ASSERT_TRUE(filter_a.check(std::string("/camera/front/image")));
+  ASSERT_FALSE(filter_a.check(std::string("/camera")));
+  ASSERT_TRUE(filter_a.check(std::string("/sensor/lidar/raw")));
+  ASSERT_FALSE(filter_a.check(std::string("/sensor/lidar/front/raw")));
+  ASSERT_FALSE(filter_a.check(std::string("/sensor/lidar/raw/image")));
+  ASSERT_TRUE(filter_a.check(std::string("/imu0")));
+  ASSERT_FALSE(filter_a.check(std::string("/imu/0")));
+
+  lbot::Filter filter_b;
+  filter_b.blacklistPattern("/camera/**");
+  filter_b.blacklist("/main");
+
+  ASSERT_FALSE(filter_b.check(std::string("/camera/front")));
+  ASSERT_FALSE(filter_b.check(std::string("/main")));
+  ASSERT_TRUE(filter_b.check(std::string("/other")));
+
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  lbot::Filter filter_c;
+  filter_c.whitelistPattern("/ma**");
+
+  std::shared_ptr<TestMessagePlugin> plugin(manager->addPlugin<TestMessagePlugin>("plugin", filter_c));
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "/main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "/other", "void"));
+
+  TestContainer message;
+  message.integral_field = 10;
+
+  node_a->sender->put(message);
+  node_b->sender->put(message);
+
+  ASSERT_EQ(plugin->message_count, 1);
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+  plugin = std::shared_ptr<TestMessagePlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin"));
+}
+
+TEST_F(ManagerTest, plugin_queue)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  lbot::DeliveryPolicy policy_a = {.queue_size = 4, .queue_policy = lbot::QueuePolicy::block_sender};
+  lbot::DeliveryPolicy policy_b = {.queue_size = 1, .queue_policy = lbot::QueuePolicy::drop_newest};
+
+  std::shared_ptr<TestMessagePlugin> plugin_a(manager->addPlugin<TestMessagePlugin>("plugin_a", lbot::Filter(), policy_a));
+  std::shared_ptr<TestGatedPlugin> plugin_b(manager->addPlugin<TestGatedPlugin>("plugin_b", lbot::Filter(), policy_b));
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node", "main", "void"));
+
+  TestContainer message;
+  message.integral_field = 10;
+
+  {
+    // The publisher must not wait for the plugin.
+    std::lock_guard guard(plugin_b->gate);
+
+    for (u64 i = 0; i < 100; ++i) {
+      node->sender->put(message);
+    }
+  }
+
+  // Queued messages are delivered by the thread of the plugin.
+  for (u64 i = 0; i < 1000 && (plugin_a->message_count != 100 || plugin_b->message_count == 0); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  ASSERT_EQ(plugin_a->message_count, 100);
+  ASSERT_GE(plugin_b->message_count, 1);
+  ASSERT_LE(plugin_b->message_count, 2);
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+  plugin_a = std::shared_ptr<TestMessagePlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin_a"));
+  plugin_b = std::shared_ptr<TestGatedPlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin_b"));
+}
+
+TEST_F(ManagerTest, plugin_queue_removal)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  lbot::DeliveryPolicy policy = {.queue_size = 16, .queue_policy = lbot::QueuePolicy::block_sender};
+
+  std::atomic<u64> message_count = 0;
+  std::shared_ptr<TestSlowPlugin> plugin(manager->addPlugin<TestSlowPlugin>("plugin", lbot::Filter(), policy, message_count));
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node", "main", "void"));
+
+  TestContainer message;
+  message.integral_field = 10;
+
+  for (u64 i = 0; i < 16; ++i) {
+    node->sender->put(message);
+  }
+
+  // Messages still queued when the plugin is removed are delivered before the removal returns.
+  plugin = std::shared_ptr<TestSlowPlugin>();
+  ASSERT_NO_THROW(manager->removePlugin("plugin"));
+
+  ASSERT_EQ(message_count, 16);
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+}
+
+TEST_F(ManagerTest, statistics)
+{
+  lbot::Config::Ptr config = lbot::Config::get();
+  config->setParameter("/lbot/statistics/interval", 10);
+
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "/main", "/main"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+  std::shared_ptr<TestNode> node_c(manager->addNode<TestNode>("node_c", "/secondary", "/secondary"));
+
+  Node::Receiver<lbot::Message<lbot::TopicStatistics>>::Ptr receiver =
+    node_b->addReceiver<lbot::Message<lbot::TopicStatistics>>("/lbot/stats/topics", nullptr, 100);
+
+  TestContainer message;
+  message.integral_field = 10;
+
+  for (u64 i = 0; i < 20; ++i) {
+    node_a->sender->put(message);
+  }
+
+  // Topics of the same message type are accounted for separately.
+  for (u64 i = 0; i < 5; ++i) {
+    node_c->sender->put(message);
+  }
+
+  // Reading the latest message skips all previous messages.
+  ASSERT_EQ(node_a->receiver->latest().integral_field, 10);
+
+  u64 message_count = 0;
+  u64 secondary_count = 0;
+  u64 overwritten_count = 0;
+  u64 max_lag = 0;
+  u32 receiver_count = 0;
+
+  // Statistics are published periodically by a dedicated thread.
+  for (u64 i = 0; i < 1000 && (message_count < 20 || overwritten_count < 19 || secondary_count < 5); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    lbot::Message<lbot::TopicStatistics> statistics;
+
+    try {
+      statistics = receiver->next();
+    } catch (lbot::TopicNoDataAvailableException &) {
+      continue;
+    }
+
+    ASSERT_GT(statistics.interval, 0);
+
+    for (const std::unique_ptr<lbot::TopicStatisticsEntryNative> &entry : statistics.topics) {
+      if (entry->topic_name == "/main") {
+        message_count += entry->message_count;
+        overwritten_count += entry->overwritten_count;
+        max_lag = std::max(max_lag, entry->max_lag);
+        receiver_count = entry->receiver_count;
+      } else if (entry->topic_name == "/secondary") {
+        secondary_count += entry->message_count;
+      }
+    }
+  }
+
+  ASSERT_EQ(message_count, 20);
+  ASSERT_EQ(secondary_count, 5);
+  ASSERT_EQ(overwritten_count, 19);
+  ASSERT_EQ(max_lag, 20);
+  ASSERT_EQ(receiver_count, 1);
+
+  receiver.reset();
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+  node_c = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_c"));
+
+  config->removeParameter("/lbot/statistics/interval");
+}
+
+TEST_F(ManagerTest, tracing)
+{
+#ifndef LBOT_ENABLE_TRACING
+  GTEST_SKIP() << "Tracing is disabled.";
+#else
+  lbot::Config::Ptr config = lbot::Config::get();
+  config->setParameter("/lbot/statistics/interval", 10);
+
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Sender<TestFlatbuffer>::Ptr sender_a = node_a->addSender<TestFlatbuffer>("/trace/a");
+  Node::Sender<TestFlatbuffer>::Ptr sender_b = node_b->addSender<TestFlatbuffer>("/trace/b");
+  Node::Receiver<TestFlatbuffer>::Ptr receiver_a = node_b->addReceiver<TestFlatbuffer>("/trace/a");
+  Node::Receiver<TestFlatbuffer>::Ptr receiver_b = node_a->addReceiver<TestFlatbuffer>("/trace/b");
+  Node::Receiver<lbot::Message<lbot::LatencyStatistics>>::Ptr receiver_latency =
+    node_a->addReceiver<lbot::Message<lbot::LatencyStatistics>>("/lbot/stats/latency", nullptr, 100);
+
+  TracingData data = {.sender = sender_b.get()};
+
+  receiver_a->setCallback(&forwardCallback, &data);
+  receiver_b->setCallback(&receiveCallback, &data);
+
+  Message<TestFlatbuffer> message;
+  message.integral_field = 10;
+
+  sender_a->put(message);
+
+  // The message sent from within the callback continues the trace.
+  ASSERT_EQ(data.forwarded.hop_count, 1);
+  ASSERT_EQ(data.received.hop_count, 2);
+  ASSERT_EQ(data.received.sequence_id, data.forwarded.sequence_id);
+  ASSERT_EQ(data.received.origin, data.forwarded.origin);
+  ASSERT_EQ(data.received.hops[0].topic_hash, std::hash<std::string>()("/trace/a"));
+  ASSERT_EQ(data.received.hops[1].topic_hash, std::hash<std::string>()("/trace/b"));
+  ASSERT_GE(data.received.hops[1].timestamp, data.received.hops[0].timestamp);
+
+  const u64 sequence_id = data.received.sequence_id;
+
+  sender_a->put(message);
+
+  ASSERT_NE(data.received.sequence_id, sequence_id);
+
+  u64 path_count = 0;
+
+  for (u64 i = 0; i < 1000 && path_count < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    lbot::Message<lbot::LatencyStatistics> statistics;
+
+    try {
+      statistics = receiver_latency->next();
+    } catch (lbot::TopicNoDataAvailableException &) {
+      continue;
+    }
+
+    for (const std::unique_ptr<lbot::LatencyPathNative> &path : statistics.paths) {
+      if (path->topics == std::vector<std::string>{"/trace/a", "/trace/b"}) {
+        path_count += path->count;
+
+        ASSERT_EQ(path->buckets.size(), lbot::Tracer::bucket_count);
+      }
+    }
+  }
+
+  ASSERT_EQ(path_count, 2);
+
+  sender_a.reset();
+  sender_b.reset();
+  receiver_a.reset();
+  receiver_b.reset();
+  receiver_latency.reset();
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+
+  config->removeParameter("/lbot/statistics/interval");
+#endif
+}
+
 }  // namespace lbot::test
 }  // namespace labrat
@@ -56,5 +56,60 @@ TEST_F(MultisetupTest, const_move)
   EXPECT_EQ(25.0, message_c.float_field);
 }
 
+class CountingMessage : public lbot::MessageBase<TestFlatbuffer, TestContainer>
+{
+public:
+  static void convertFrom(const TestContainer &source, Storage &destination, std::atomic<u64> *conversions)
+  {
+    destination.integral_field = source.integral_field;
+    destination.float_field = source.float_field;
+    destination.buffer = source.buffer;
+    ++(*conversions);
+  }
+
+  static void convertTo(const Storage &source, TestContainer &destination)
+  {
+    destination.integral_field = source.integral_field;
+    destination.float_field = source.float_field;
+    destination.buffer = source.buffer;
+  }
+};
+
+TEST_F(MultisetupTest, shared_fan_out)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_sender(manager->addNode<TestNode>("node_sender"));
+  std::shared_ptr<TestNode> node_receiver(manager->addNode<TestNode>("node_receiver"));
+
+  std::atomic<u64> conversions = 0;
+
+  Node::Sender<CountingMessage>::Ptr sender = node_sender->addSender<CountingMessage>("/topic", &conversions, FanOutPolicy::shared);
+  Node::Receiver<CountingMessage>::Ptr receiver_a = node_receiver->addReceiver<CountingMessage>("/topic");
+  Node::Receiver<CountingMessage>::Ptr receiver_b = node_receiver->addReceiver<CountingMessage>("/topic");
+  Node::Receiver<CountingMessage>::Ptr receiver_c = node_receiver->addReceiver<CountingMessage>("/topic");
+
+  TestContainer message_a;
+  message_a.integral_field = 10;
+  message_a.float_field = 5.0;
+  message_a.buffer.resize(1000, 42);
+  sender->put(message_a);
+
+  EXPECT_EQ(1, conversions);
+
+  TestContainer message_b = receiver_a->next();
+  TestContainer message_c = receiver_b->latest();
+  TestContainer message_d = receiver_c->next();
+
+  EXPECT_EQ(message_a, message_b);
+  EXPECT_EQ(message_a, message_c);
+  EXPECT_EQ(message_a, message_d);
+  EXPECT_EQ(message_a, receiver_b->latest());
+
+  sender->put(message_a);
+
+  EXPECT_EQ(2, conversions);
+}
+
 }  // namespace lbot::test
 }  // namespace labrat
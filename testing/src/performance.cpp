@@ -205,6 +205,50 @@ TEST_P(PerformanceTest, callback_multi)
   ASSERT_NO_THROW(manager->removeNode("node_d"));
 }
 
+TEST_P(PerformanceTest, callback_pooled)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void1", "main"));
+  std::shared_ptr<TestNode> node_c(manager->addNode<TestNode>("node_c", "void2", "main"));
+  std::shared_ptr<TestNode> node_d(manager->addNode<TestNode>("node_d", "void3", "main"));
+
+  TestContainer message_a;
+  message_a.integral_field = 42;
+  message_a.buffer.resize(GetParam().size);
+
+  TestContainer message_b;
+  TestContainer message_c;
+  TestContainer message_d;
+
+  auto lambda = [](const TestContainer &message, TestContainer *destination) -> void {
+    *destination = message;
+  };
+  void (*callback)(const TestContainer &message, TestContainer *destination) = lambda;
+
+  node_b->receiver->setCallback(callback, &message_b, lbot::ExecutionPolicy::pooled);
+  node_c->receiver->setCallback(callback, &message_c, lbot::ExecutionPolicy::pooled);
+  node_d->receiver->setCallback(callback, &message_d, lbot::ExecutionPolicy::pooled);
+
+  for (u64 i = 0; i < GetParam().limit; ++i) {
+    node_a->sender->put(message_a);
+  }
+
+  EXPECT_EQ(message_a, message_b);
+  EXPECT_EQ(message_a, message_c);
+  EXPECT_EQ(message_a, message_d);
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+  node_c = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_c"));
+  node_d = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_d"));
+}
+
 INSTANTIATE_TEST_SUITE_P(
   performance,
   PerformanceTest,
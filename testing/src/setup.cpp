@@ -1,6 +1,9 @@
 #include <labrat/lbot/manager.hpp>
 
+#include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -126,6 +129,477 @@ TEST_F(SetupTest, next)
   ASSERT_NO_THROW(manager->removeNode("node_b"));
 }
 
+TEST_F(SetupTest, trivial)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Receiver<TestMessageTrivial>::Ptr receiver = node_b->addReceiver<TestMessageTrivial>("main");
+
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  TestContainer message_a;
+  message_a.integral_field = 10;
+  message_a.float_field = 5.0;
+
+  node_a->sender->put(message_a);
+
+  TestTrivialContainer message_b = receiver->latest();
+
+  ASSERT_EQ(message_b.integral_field, 10);
+  ASSERT_EQ(message_b.float_field, 5.0);
+
+  TestContainer message_c;
+  message_c.integral_field = 5;
+  message_c.float_field = 10.0;
+
+  node_a->sender->put(message_c);
+
+  TestTrivialContainer message_d = receiver->next();
+
+  ASSERT_EQ(message_d.integral_field, 5);
+  ASSERT_EQ(message_d.float_field, 10.0);
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  node_a->sender->put(message_a);
+
+  ASSERT_EQ(receiver->latest(), message_b);
+  ASSERT_EQ(receiver->latest(), message_b);
+
+  node_a->sender->flush();
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  receiver.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, view)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  Node::ViewReceiver<TestFlatbuffer>::Ptr receiver = node_b->addViewReceiver<TestFlatbuffer>("main");
+
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  TestContainer message_a;
+  message_a.integral_field = 10;
+  message_a.float_field = 5.0;
+
+  node_a->sender->put(message_a);
+
+  MessageView<TestFlatbuffer> view_a = receiver->latest();
+
+  ASSERT_TRUE(view_a.valid());
+  ASSERT_EQ(view_a->integral_field(), 10);
+  ASSERT_EQ(view_a->float_field(), 5.0);
+  ASSERT_EQ(node_b->receiver->latest(), message_a);
+
+  TestContainer message_b;
+  message_b.integral_field = 5;
+  message_b.float_field = 10.0;
+
+  node_a->sender->put(std::move(message_b));
+
+  MessageView<TestFlatbuffer> view_b = receiver->next();
+
+  ASSERT_EQ(view_b->integral_field(), 5);
+  ASSERT_EQ(view_b->float_field(), 10.0);
+  ASSERT_EQ(view_a->integral_field(), 10);
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  node_a->sender->flush();
+  ASSERT_THROW(receiver->latest(), labrat::lbot::TopicNoDataAvailableException);
+
+  receiver.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, queue)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_overwrite = node_b->addReceiver<TestMessageConv>("main", nullptr, 4);
+  Node::Receiver<TestMessageConv>::Ptr receiver_drop =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 4, lbot::QueuePolicy::drop_newest);
+  Node::Receiver<TestMessageConv>::Ptr receiver_block =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 4, lbot::QueuePolicy::block_sender, std::chrono::milliseconds(10));
+
+  ASSERT_EQ(receiver_overwrite->getQueuePolicy(), lbot::QueuePolicy::overwrite_oldest);
+  ASSERT_EQ(receiver_drop->getQueuePolicy(), lbot::QueuePolicy::drop_newest);
+  ASSERT_EQ(receiver_block->getQueuePolicy(), lbot::QueuePolicy::block_sender);
+
+  for (u64 i = 1; i <= 6; ++i) {
+    TestContainer message;
+    message.integral_field = i;
+
+    node_a->sender->put(message);
+  }
+
+  ASSERT_EQ(receiver_overwrite->next().integral_field, 6);
+  ASSERT_EQ(receiver_overwrite->getOverwrittenCount(), 5);
+  ASSERT_EQ(receiver_overwrite->getDroppedCount(), 0);
+
+  for (u64 i = 1; i <= 4; ++i) {
+    ASSERT_EQ(receiver_drop->next().integral_field, i);
+    ASSERT_EQ(receiver_block->next().integral_field, i);
+  }
+
+  ASSERT_THROW(receiver_drop->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+  ASSERT_EQ(receiver_drop->getDroppedCount(), 2);
+  ASSERT_EQ(receiver_drop->getOverwrittenCount(), 0);
+  ASSERT_EQ(receiver_block->getDroppedCount(), 2);
+  ASSERT_EQ(receiver_block->getOverwrittenCount(), 0);
+
+  receiver_overwrite.reset();
+  receiver_drop.reset();
+  receiver_block = node_b->addReceiver<TestMessageConv>("main", nullptr, 4, lbot::QueuePolicy::block_sender);
+
+  const u64 limit = 100;
+
+  auto sender_lambda = [&node_a]() {
+    for (u64 i = 2; i <= limit; ++i) {
+      TestContainer message;
+      message.integral_field = i;
+
+      node_a->sender->put(message);
+    }
+  };
+
+  TestContainer message;
+  message.integral_field = 1;
+  node_a->sender->put(message);
+
+  std::thread sender_thread(sender_lambda);
+
+  for (u64 i = 1; i <= limit; ++i) {
+    EXPECT_EQ(receiver_block->next().integral_field, i);
+  }
+
+  sender_thread.join();
+
+  ASSERT_EQ(receiver_block->getDroppedCount(), 0);
+
+  receiver_block.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, batch)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_drop =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 4, lbot::QueuePolicy::drop_newest);
+  Node::ViewReceiver<TestFlatbuffer>::Ptr receiver_view = node_b->addViewReceiver<TestFlatbuffer>("main");
+
+  std::vector<TestContainer> messages(6);
+  for (u64 i = 0; i < messages.size(); ++i) {
+    messages[i].integral_field = i + 1;
+  }
+
+  node_a->sender->putBatch(messages);
+
+  ASSERT_EQ(node_b->receiver->latest().integral_field, 6);
+
+  for (u64 i = 1; i <= 4; ++i) {
+    ASSERT_EQ(receiver_drop->next().integral_field, i);
+  }
+
+  ASSERT_EQ(receiver_drop->getDroppedCount(), 2);
+
+  ASSERT_EQ(receiver_view->latest()->integral_field(), 6);
+
+  node_a->sender->putBatch({});
+  ASSERT_THROW(receiver_drop->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+  receiver_drop.reset();
+  receiver_view.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, drain)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main", 4));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_drop =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 8, lbot::QueuePolicy::drop_newest);
+  Node::ViewReceiver<TestFlatbuffer>::Ptr receiver_view =
+    node_b->addViewReceiver<TestFlatbuffer>("main", 8, lbot::QueuePolicy::drop_newest);
+
+  std::vector<TestContainer> drained;
+  ASSERT_THROW(receiver_drop->drainInto(std::back_inserter(drained)), labrat::lbot::TopicNoDataAvailableException);
+
+  TestContainer message;
+  for (u64 i = 1; i <= 6; ++i) {
+    message.integral_field = i;
+    node_a->sender->put(message);
+  }
+
+  ASSERT_EQ(receiver_drop->drainInto(std::back_inserter(drained), 4), 4);
+  ASSERT_EQ(receiver_drop->drainInto(std::back_inserter(drained)), 2);
+  ASSERT_EQ(receiver_drop->drainInto(std::back_inserter(drained)), 0);
+
+  for (u64 i = 0; i < drained.size(); ++i) {
+    ASSERT_EQ(drained[i].integral_field, i + 1);
+  }
+
+  const std::vector<TestContainer> batch = node_b->receiver->nextBatch(10);
+  ASSERT_EQ(batch.size(), 4);
+  ASSERT_EQ(batch.front().integral_field, 3);
+  ASSERT_EQ(batch.back().integral_field, 6);
+  ASSERT_EQ(node_b->receiver->getOverwrittenCount(), 2);
+
+  const std::vector<MessageView<TestFlatbuffer>> views = receiver_view->nextBatch(3);
+  ASSERT_EQ(views.size(), 3);
+  ASSERT_EQ(views.back()->integral_field(), 3);
+  ASSERT_EQ(receiver_view->nextBatch(10).size(), 3);
+
+  ASSERT_THROW(receiver_drop->nextBatch(0), labrat::lbot::InvalidArgumentException);
+  ASSERT_THROW(receiver_drop->nextBatch(10, std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+  receiver_drop.reset();
+  receiver_view.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, wait_set)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+  std::shared_ptr<TestNode> node_c(manager->addNode<TestNode>("node_c", "side", "void"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_side = node_b->addReceiver<TestMessageConv>("side");
+
+  labrat::lbot::WaitSet wait_set;
+  wait_set.attach(*node_b->receiver);
+  wait_set.attach(*receiver_side);
+
+  ASSERT_EQ(wait_set.size(), 2);
+  ASSERT_THROW(wait_set.attach(*receiver_side), labrat::lbot::BadUsageException);
+  ASSERT_TRUE(wait_set.wait(std::chrono::milliseconds(10)).empty());
+
+  TestContainer message;
+  message.integral_field = 1;
+  node_c->sender->put(message);
+
+  std::vector<labrat::lbot::Waitable *> ready = wait_set.wait(std::chrono::milliseconds(100));
+  ASSERT_EQ(ready.size(), 1);
+  ASSERT_EQ(ready.front(), receiver_side.get());
+  ASSERT_EQ(receiver_side->next().integral_field, 1);
+
+  std::thread thread([&node_a]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    TestContainer local_message;
+    local_message.integral_field = 2;
+    node_a->sender->put(local_message);
+  });
+
+  ready = wait_set.wait();
+  thread.join();
+
+  ASSERT_EQ(ready.size(), 1);
+  ASSERT_EQ(ready.front(), node_b->receiver.get());
+  ASSERT_EQ(node_b->receiver->next().integral_field, 2);
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+
+  // The result vector is cleared before it is filled.
+  wait_set.wait(ready, std::chrono::milliseconds(100));
+  ASSERT_EQ(ready.size(), 1);
+  ASSERT_THROW(node_b->receiver->next(), labrat::lbot::TopicNoDataAvailableException);
+
+  wait_set.detach(*node_b->receiver);
+  ASSERT_THROW(wait_set.detach(*node_b->receiver), labrat::lbot::BadUsageException);
+
+  receiver_side.reset();
+  ASSERT_EQ(wait_set.size(), 0);
+
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+  node_c = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_c"));
+}
+
+TEST_F(SetupTest, reuse)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "", "main", 4));
+
+  Node::Sender<TestMessageConv>::Ptr sender = node_a->addSender<TestMessageConv>(
+    "main", nullptr, lbot::FanOutPolicy::copy, lbot::SenderPolicy::exclusive, lbot::StoragePolicy::reuse
+  );
+  Node::Receiver<TestMessageConv>::Ptr receiver_drop =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 64, lbot::QueuePolicy::drop_newest);
+
+  TestContainer message;
+  for (u64 i = 0; i < 50; ++i) {
+    // Alternate the buffer size, so that stale contents of recycled messages would show up.
+    message.integral_field = i;
+    message.float_field = static_cast<double>(i) / 2;
+    message.buffer.assign((i % 2 == 0) ? 1000 : 10, static_cast<u8>(i));
+
+    sender->put(message);
+
+    ASSERT_EQ(node_b->receiver->latest(), message);
+  }
+
+  for (u64 i = 0; i < 50; ++i) {
+    const TestContainer result = receiver_drop->next();
+
+    ASSERT_EQ(result.integral_field, i);
+    ASSERT_EQ(result.buffer.size(), (i % 2 == 0) ? 1000 : 10);
+    ASSERT_EQ(result.buffer.back(), static_cast<u8>(i));
+  }
+
+  sender.reset();
+  receiver_drop.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, rate_limit)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_decimate =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 16, lbot::QueuePolicy::drop_newest);
+  Node::Receiver<TestMessageConv>::Ptr receiver_interval =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 16, lbot::QueuePolicy::drop_newest);
+  Node::ViewReceiver<TestFlatbuffer>::Ptr receiver_view =
+    node_b->addViewReceiver<TestFlatbuffer>("main", 16, lbot::QueuePolicy::drop_newest);
+
+  receiver_decimate->setRateLimit({.decimation = 3});
+  receiver_interval->setRateLimit({.min_interval = std::chrono::hours(1)});
+  receiver_view->setRateLimit({.decimation = 2});
+
+  ASSERT_THROW(receiver_interval->setRateLimit({.max_rate = -1.0}), labrat::lbot::InvalidArgumentException);
+
+  TestContainer message;
+  for (u64 i = 1; i <= 5; ++i) {
+    message.integral_field = i;
+    node_a->sender->put(message);
+  }
+
+  std::vector<TestContainer> messages(4);
+  for (u64 i = 0; i < messages.size(); ++i) {
+    messages[i].integral_field = i + 6;
+  }
+
+  node_a->sender->putBatch(messages);
+
+  ASSERT_EQ(node_b->receiver->latest().integral_field, 9);
+
+  for (u64 i = 1; i <= 9; i += 3) {
+    ASSERT_EQ(receiver_decimate->next().integral_field, i);
+  }
+
+  ASSERT_THROW(receiver_decimate->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+  ASSERT_EQ(receiver_interval->next().integral_field, 1);
+  ASSERT_THROW(receiver_interval->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+  for (u64 i = 1; i <= 9; i += 2) {
+    ASSERT_EQ(receiver_view->next()->integral_field(), i);
+  }
+
+  receiver_decimate.reset();
+  receiver_interval.reset();
+  receiver_view.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(SetupTest, rate_limit_batch)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver_interval =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 16, lbot::QueuePolicy::drop_newest);
+  Node::Receiver<TestMessageConv>::Ptr receiver_rate =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 16, lbot::QueuePolicy::drop_newest);
+
+  receiver_interval->setRateLimit({.min_interval = std::chrono::milliseconds(20)});
+  receiver_rate->setRateLimit({.decimation = 2, .max_rate = 50.0});
+
+  std::vector<TestContainer> messages(4);
+
+  // A batch counts as a single instant, so that only its first accepted message passes the interval limit.
+  for (u64 batch = 0; batch < 2; ++batch) {
+    for (u64 i = 0; i < messages.size(); ++i) {
+      messages[i].integral_field = batch * messages.size() + i + 1;
+    }
+
+    node_a->sender->putBatch(messages);
+
+    ASSERT_EQ(receiver_interval->next().integral_field, batch * messages.size() + 1);
+    ASSERT_THROW(receiver_interval->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+    ASSERT_EQ(receiver_rate->next().integral_field, batch * messages.size() + 1);
+    ASSERT_THROW(receiver_rate->next(std::chrono::milliseconds(10)), labrat::lbot::TopicTimeoutException);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  }
+
+  receiver_interval.reset();
+  receiver_rate.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
 TEST_F(SetupTest, move)
 {
   labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
@@ -234,5 +708,84 @@ TEST_F(SetupTest, server)
   ASSERT_NO_THROW(manager->removeNode("node_b"));
 }
 
+TEST_F(SetupTest, server_workers)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main"));
+
+  struct HandlerData
+  {
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+  } data;
+
+  auto handler = [](const TestContainer &request, HandlerData *user_ptr) -> TestContainer {
+    {
+      std::lock_guard guard(user_ptr->mutex);
+      user_ptr->threads.emplace(std::this_thread::get_id());
+    }
+
+    TestContainer response;
+    response.integral_field = 2 * request.integral_field;
+    return response;
+  };
+
+  TestContainer (*ptr)(const TestContainer &, HandlerData *) = handler;
+
+  Node::Server<TestMessageConv, TestMessageConv>::Ptr server = node_a->addServer<TestMessageConv, TestMessageConv>("test_service");
+  server->setHandler(ptr, &data);
+  server->setWorkers(2);
+  ASSERT_THROW(server->setWorkers(2), labrat::lbot::BadUsageException);
+  Node::Client<TestMessageConv, TestMessageConv>::Ptr client = node_b->addClient<TestMessageConv, TestMessageConv>("test_service");
+
+  std::vector<Node::Client<TestMessageConv, TestMessageConv>::Future> futures;
+
+  for (u64 i = 0; i < 100; ++i) {
+    TestContainer request;
+    request.integral_field = i;
+    futures.emplace_back(client->callAsync(request, i % 2 ? ExecutionPolicy::pooled : ExecutionPolicy::parallel));
+  }
+
+  for (u64 i = 0; i < 100; ++i) {
+    ASSERT_EQ(futures[i].get().integral_field, 2 * i);
+  }
+
+  // All requests have been handled by the two workers.
+  ASSERT_LE(data.threads.size(), 2);
+  ASSERT_FALSE(data.threads.contains(std::this_thread::get_id()));
+
+  // Serial requests are still handled by the calling thread.
+  TestContainer request;
+  request.integral_field = 4;
+  ASSERT_EQ(client->callSync(request).integral_field, 8);
+  ASSERT_TRUE(data.threads.contains(std::this_thread::get_id()));
+
+  futures.clear();
+
+  for (u64 i = 0; i < 100; ++i) {
+    TestContainer queued_request;
+    queued_request.integral_field = i;
+    futures.emplace_back(client->callAsync(queued_request, ExecutionPolicy::parallel));
+  }
+
+  // Requests still queued when the server is destroyed are handled before it is removed.
+  server.reset(nullptr);
+
+  for (u64 i = 0; i < 100; ++i) {
+    ASSERT_EQ(futures[i].get().integral_field, 2 * i);
+  }
+
+  Node::Client<TestMessageConv, TestMessageConv>::Future future = client->callAsync(request, ExecutionPolicy::pooled);
+  ASSERT_THROW(future.get(), labrat::lbot::ServiceUnavailableException);
+
+  client.reset(nullptr);
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
 }  // namespace lbot::test
 }  // namespace labrat
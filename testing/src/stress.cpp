@@ -55,6 +55,177 @@ TEST_F(StressTest, put_latest)
   ASSERT_NO_THROW(manager->removeNode("node_b"));
 }
 
+TEST_F(StressTest, put_latest_concurrent)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b", "void", "main", 4));
+
+  const u64 limit = 1000000;
+
+  auto sender_lambda = [&node_a]() {
+    for (u64 i = 1; i <= limit; ++i) {
+      TestContainer message;
+      message.integral_field = i;
+      message.buffer.resize(i % 16);
+
+      node_a->sender->put(message);
+    }
+  };
+
+  auto receiver_lambda = [&node_b]() {
+    u64 last_integral = 0;
+    while (last_integral < limit) {
+      try {
+        TestContainer message = node_b->receiver->latest();
+
+        EXPECT_GE(message.integral_field, last_integral);
+        EXPECT_EQ(message.buffer.size(), message.integral_field % 16);
+
+        last_integral = message.integral_field;
+      } catch (TopicNoDataAvailableException &) {
+        EXPECT_EQ(last_integral, 0);
+      }
+    }
+  };
+
+  std::vector<std::thread> receiver_threads;
+  for (u32 i = 0; i < 4; ++i) {
+    receiver_threads.emplace_back(receiver_lambda);
+  }
+
+  std::thread sender_thread(sender_lambda);
+
+  sender_thread.join();
+
+  for (std::thread &thread : receiver_threads) {
+    thread.join();
+  }
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(StressTest, put_receiver_churn)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  const u64 limit = 100000;
+  std::atomic_flag done;
+
+  auto sender_lambda = [&node_a, &done]() {
+    for (u64 i = 1; i <= limit; ++i) {
+      TestContainer message;
+      message.integral_field = i;
+
+      node_a->sender->put(message);
+    }
+
+    done.test_and_set();
+  };
+
+  auto receiver_lambda = [&node_b, &done, &limit]() {
+    while (!done.test()) {
+      Node::Receiver<TestMessage>::Ptr receiver = node_b->addReceiver<TestMessage>("main");
+
+      try {
+        EXPECT_LE(receiver->latest().integral_field, limit);
+      } catch (TopicNoDataAvailableException &) {
+      }
+    }
+  };
+
+  std::vector<std::thread> receiver_threads;
+  for (u32 i = 0; i < 4; ++i) {
+    receiver_threads.emplace_back(receiver_lambda);
+  }
+
+  std::thread sender_thread(sender_lambda);
+
+  sender_thread.join();
+
+  for (std::thread &thread : receiver_threads) {
+    thread.join();
+  }
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(StressTest, put_shared_senders)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node"));
+
+  const u64 limit = 100000;
+  const u64 sender_count = 4;
+
+  Node::Receiver<TestMessage>::Ptr receiver = node->addReceiver<TestMessage>("shared", nullptr, 16, QueuePolicy::block_sender);
+
+  std::vector<Node::Sender<TestMessage>::Ptr> senders;
+  for (u64 i = 0; i < sender_count; ++i) {
+    senders.emplace_back(node->addSender<TestMessage>("shared", nullptr, FanOutPolicy::copy, SenderPolicy::shared));
+  }
+
+  ASSERT_THROW(node->addSender<TestMessage>("shared"), ManagementException);
+
+  auto sender_lambda = [&limit](Node::Sender<TestMessage> &sender, u64 index) {
+    for (u64 i = 1; i <= limit; ++i) {
+      TestMessage message;
+      message.integral_field = i;
+      message.float_field = index;
+
+      sender.put(message);
+    }
+  };
+
+  std::vector<std::thread> sender_threads;
+  for (u64 i = 0; i < sender_count; ++i) {
+    sender_threads.emplace_back(sender_lambda, std::ref(*senders[i]), i);
+  }
+
+  // Messages of each sender must arrive completely and in order.
+  std::vector<u64> last_integrals(sender_count, 0);
+  for (u64 i = 0; i < sender_count * limit;) {
+    TestMessage message;
+
+    try {
+      message = receiver->next();
+    } catch (TopicNoDataAvailableException &) {
+      // No message has been sent yet.
+      EXPECT_EQ(i, 0);
+      continue;
+    }
+
+    ++i;
+    u64 &last_integral = last_integrals[static_cast<std::size_t>(message.float_field)];
+
+    EXPECT_EQ(message.integral_field, last_integral + 1);
+    last_integral = message.integral_field;
+  }
+
+  for (std::thread &thread : sender_threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(receiver->getDroppedCount(), 0);
+
+  senders.clear();
+  receiver.reset();
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+}
+
 TEST_F(StressTest, put_next)
 {
   labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
@@ -105,6 +276,71 @@ TEST_F(StressTest, put_next)
   ASSERT_NO_THROW(manager->removeNode("node_b"));
 }
 
+TEST_F(StressTest, put_latest_next_trivial)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Sender<TestMessageTrivial>::Ptr sender = node_a->addSender<TestMessageTrivial>("main");
+  Node::Receiver<TestMessageTrivial>::Ptr receiver = node_b->addReceiver<TestMessageTrivial>("main", nullptr, 4);
+
+  const u64 limit = 1000000;
+  std::atomic_flag done;
+
+  auto sender_lambda = [&sender, &done]() {
+    for (u64 i = 1; i <= limit; ++i) {
+      TestTrivialContainer message;
+      message.integral_field = i;
+
+      sender->put(message);
+    }
+
+    while (!done.test()) {
+      sender->flush();
+    }
+  };
+
+  std::thread sender_thread(sender_lambda);
+
+  // Messages returned by next() must always be newer than the message previously returned by latest().
+  u64 last_integral = 0;
+  while (last_integral < limit) {
+    try {
+      TestTrivialContainer message = receiver->latest();
+
+      EXPECT_GE(message.integral_field, last_integral);
+
+      last_integral = message.integral_field;
+    } catch (TopicNoDataAvailableException &) {
+    }
+
+    try {
+      TestTrivialContainer message = receiver->next();
+
+      EXPECT_GT(message.integral_field, last_integral);
+
+      last_integral = message.integral_field;
+    } catch (TopicNoDataAvailableException &) {
+      if (last_integral != 0) {
+        break;
+      }
+    }
+  }
+
+  done.test_and_set();
+
+  sender_thread.join();
+
+  sender.reset();
+  receiver.reset();
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
 TEST_F(StressTest, move_latest)
 {
   labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
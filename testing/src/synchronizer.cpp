@@ -0,0 +1,133 @@
+#include <labrat/lbot/manager.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <helper.hpp>
+
+inline namespace labrat {
+namespace lbot::test {
+
+class SynchronizerTest : public LbotTest
+{};
+
+using MatchList = std::vector<std::pair<u64, u64>>;
+
+static void matchCallback(const TestMessage &message_a, const TestMessage &message_b, MatchList *matches)
+{
+  matches->emplace_back(message_a.integral_field, message_b.integral_field);
+}
+
+static TestMessage createMessage(Clock::time_point timestamp, u64 value)
+{
+  TestMessage result = TestMessage::Super(timestamp);
+  result.integral_field = value;
+
+  return result;
+}
+
+TEST_F(SynchronizerTest, exact)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node"));
+
+  Node::Sender<TestFlatbuffer>::Ptr sender_a = node->addSender<TestFlatbuffer>("/a");
+  Node::Sender<TestFlatbuffer>::Ptr sender_b = node->addSender<TestFlatbuffer>("/b");
+
+  Node::Synchronizer<TestFlatbuffer, TestFlatbuffer>::Ptr synchronizer =
+    node->addSynchronizer<TestFlatbuffer, TestFlatbuffer>({"/a", "/b"}, lbot::SyncPolicy::exact);
+
+  const Clock::time_point start = Clock::now();
+  const auto time = [start](u64 milliseconds) -> Clock::time_point {
+    return start + std::chrono::milliseconds(milliseconds);
+  };
+
+  // Messages received before the callback has been registered are matched as well.
+  sender_a->put(createMessage(time(0), 0));
+  sender_a->put(createMessage(time(1), 1));
+  sender_b->put(createMessage(time(1), 11));
+
+  MatchList matches;
+  synchronizer->setCallback(&matchCallback, &matches);
+
+  ASSERT_EQ(matches, MatchList({{1, 11}}));
+
+  sender_b->put(createMessage(time(2), 12));
+  sender_b->put(createMessage(time(3), 13));
+  sender_a->put(createMessage(time(3), 3));
+
+  ASSERT_EQ(matches, MatchList({{1, 11}, {3, 13}}));
+  ASSERT_EQ(synchronizer->getDroppedCount(), 2);
+
+  ASSERT_THROW(synchronizer->setCallback(&matchCallback, &matches), labrat::lbot::BadUsageException);
+
+  synchronizer.reset();
+  sender_a.reset();
+  sender_b.reset();
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+}
+
+TEST_F(SynchronizerTest, approximate)
+{
+  labrat::lbot::Manager::Ptr manager = labrat::lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node(manager->addNode<TestNode>("node"));
+
+  Node::Sender<TestFlatbuffer>::Ptr sender_a = node->addSender<TestFlatbuffer>("/a");
+  Node::Sender<TestFlatbuffer>::Ptr sender_b = node->addSender<TestFlatbuffer>("/b");
+
+  ASSERT_THROW(
+    (node->addSynchronizer<TestFlatbuffer, TestFlatbuffer>({"/a", "/b"}, lbot::SyncPolicy::approximate, std::chrono::milliseconds(-1))),
+    labrat::lbot::InvalidArgumentException
+  );
+
+  Node::Synchronizer<TestFlatbuffer, TestFlatbuffer>::Ptr synchronizer =
+    node->addSynchronizer<TestFlatbuffer, TestFlatbuffer>({"/a", "/b"}, lbot::SyncPolicy::approximate, std::chrono::milliseconds(2));
+
+  MatchList matches;
+  synchronizer->setCallback(&matchCallback, &matches);
+
+  const Clock::time_point start = Clock::now();
+  const auto time = [start](u64 milliseconds) -> Clock::time_point {
+    return start + std::chrono::milliseconds(milliseconds);
+  };
+
+  sender_a->put(createMessage(time(0), 0));
+  sender_b->put(createMessage(time(1), 1));
+
+  // A later message on the first topic might still be a closer match.
+  ASSERT_TRUE(matches.empty());
+
+  sender_a->put(createMessage(time(10), 10));
+  sender_b->put(createMessage(time(12), 12));
+  sender_a->put(createMessage(time(20), 20));
+
+  ASSERT_EQ(matches, MatchList({{0, 1}, {10, 12}}));
+
+  // The closest message on the first topic is too far apart.
+  sender_b->put(createMessage(time(35), 35));
+  sender_a->put(createMessage(time(40), 40));
+
+  ASSERT_EQ(matches, MatchList({{0, 1}, {10, 12}}));
+  ASSERT_EQ(synchronizer->getDroppedCount(), 1);
+
+  sender_b->put(createMessage(time(41), 41));
+  sender_a->put(createMessage(time(50), 50));
+
+  ASSERT_EQ(matches, MatchList({{0, 1}, {10, 12}, {40, 41}}));
+
+  synchronizer.reset();
+  sender_a.reset();
+  sender_b.reset();
+
+  node = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node"));
+}
+
+}  // namespace lbot::test
+}  // namespace labrat
@@ -1,7 +1,10 @@
 #include <labrat/lbot/manager.hpp>
+#include <labrat/lbot/utils/coroutine.hpp>
+#include <labrat/lbot/utils/executor.hpp>
 #include <labrat/lbot/utils/thread.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -21,6 +24,62 @@ void test_func(std::vector<int> vec, int *loop_count, std::atomic_bool *exit_fla
   }
 }
 
+static lbot::Task<u64> addDelayed(u64 value)
+{
+  co_await lbot::sleepFor(std::chrono::milliseconds(1));
+  co_return value + 1;
+}
+
+static lbot::Task<void> sumDelayed(u64 count, std::atomic<u64> *sum)
+{
+  for (u64 i = 0; i < count; ++i) {
+    *sum += co_await addDelayed(i);
+  }
+}
+
+static lbot::Task<void> sumReceived(Node::Receiver<TestMessageConv> *receiver, u64 count, std::atomic<u64> *sum)
+{
+  for (u64 i = 0; i < count; ++i) {
+    const TestContainer message = co_await receiver->nextAsync();
+    *sum += message.integral_field;
+  }
+}
+
+static lbot::Task<void> callService(Node::Client<TestMessageConv, TestMessageConv> *client, std::atomic<u64> *result)
+{
+  TestContainer request;
+  request.integral_field = 20;
+
+  const TestContainer response = co_await client->call(request);
+  *result = response.integral_field;
+}
+
+static lbot::Task<void> throwException()
+{
+  co_await lbot::sleepFor(std::chrono::milliseconds(1));
+  throw lbot::RuntimeException("Test exception.");
+}
+
+static TestContainer handlerDouble(const TestContainer &request)
+{
+  TestContainer response;
+  response.integral_field = request.integral_field * 2;
+
+  return response;
+}
+
+static std::atomic<bool> slow_handler_flag = false;
+
+static TestContainer handlerSlow(const TestContainer &request)
+{
+  slow_handler_flag = true;
+  slow_handler_flag.notify_all();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  return handlerDouble(request);
+}
+
 class ThreadTest : public LbotTest
 {};
 
@@ -50,5 +109,190 @@ TEST_F(ThreadTest, timer)
   }
 }
 
+TEST_F(ThreadTest, executor)
+{
+  lbot::Executor executor(4);
+  ASSERT_EQ(executor.getThreadCount(), 4);
+
+  std::atomic<int> count = 0;
+
+  {
+    lbot::Executor::Group group;
+
+    for (int i = 0; i < 100; ++i) {
+      executor.submit(group, [&executor, &count]() {
+        // Nested groups must not deadlock, even when all workers are busy.
+        lbot::Executor::Group nested_group;
+
+        for (int j = 0; j < 10; ++j) {
+          executor.submit(nested_group, [&count]() {
+            ++count;
+          });
+        }
+
+        nested_group.wait();
+      });
+    }
+
+    group.wait();
+  }
+
+  EXPECT_EQ(count, 1000);
+
+  lbot::Executor::Group group;
+  executor.submit(group, []() {
+    throw lbot::Exception("test");
+  });
+
+  EXPECT_THROW(group.wait(), lbot::Exception);
+}
+
+TEST_F(ThreadTest, executor_group_isolation)
+{
+  lbot::Executor executor(1);
+
+  std::atomic<bool> block_flag = true;
+  std::atomic<bool> unrelated_flag = false;
+
+  // Keep the only worker busy, so that the following tasks remain queued.
+  executor.submit([&block_flag]() {
+    while (block_flag.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  executor.submit([&unrelated_flag]() {
+    unrelated_flag = true;
+  });
+
+  std::atomic<int> count = 0;
+
+  {
+    lbot::Executor::Group group;
+
+    for (int i = 0; i < 10; ++i) {
+      executor.submit(group, [&count]() {
+        ++count;
+      });
+    }
+
+    group.wait();
+  }
+
+  // Waiting for a group only helps with the tasks of that group.
+  EXPECT_EQ(count, 10);
+  EXPECT_FALSE(unrelated_flag);
+
+  block_flag = false;
+}
+
+TEST_F(ThreadTest, executor_drain)
+{
+  std::atomic<int> count = 0;
+
+  {
+    lbot::Executor executor(1);
+
+    for (int i = 0; i < 100; ++i) {
+      executor.submit([&count]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ++count;
+      });
+    }
+  }
+
+  // Tasks still pending upon destruction are completed.
+  EXPECT_EQ(count, 100);
+}
+
+TEST_F(ThreadTest, coroutine)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a", "main", "void"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Receiver<TestMessageConv>::Ptr receiver =
+    node_b->addReceiver<TestMessageConv>("main", nullptr, 4, lbot::QueuePolicy::block_sender);
+  Node::Server<TestMessageConv, TestMessageConv>::Ptr server = node_a->addServer<TestMessageConv, TestMessageConv>("service");
+  server->setHandler(handlerDouble);
+  Node::Client<TestMessageConv, TestMessageConv>::Ptr client = node_b->addClient<TestMessageConv, TestMessageConv>("service");
+
+  static const u64 count = 100;
+
+  std::atomic<u64> delayed_sum = 0;
+  std::atomic<u64> received_sum = 0;
+  std::atomic<u64> response = 0;
+
+  {
+    lbot::Scheduler scheduler(2);
+
+    scheduler.spawn(sumDelayed(10, &delayed_sum));
+    scheduler.spawn(sumReceived(receiver.get(), count, &received_sum));
+    scheduler.spawn(callService(client.get(), &response));
+
+    TestContainer message;
+    for (u64 i = 1; i <= count; ++i) {
+      message.integral_field = i;
+      node_a->sender->put(message);
+    }
+
+    ASSERT_NO_THROW(scheduler.wait());
+
+    scheduler.spawn(throwException());
+    ASSERT_THROW(scheduler.wait(), lbot::RuntimeException);
+
+    // Coroutines that are still suspended are destroyed along with the scheduler.
+    scheduler.spawn(sumReceived(receiver.get(), 1, &received_sum));
+  }
+
+  ASSERT_EQ(delayed_sum, 55);
+  ASSERT_EQ(received_sum, count * (count + 1) / 2);
+  ASSERT_EQ(response, 40);
+
+  receiver.reset();
+  server.reset();
+  client.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
+TEST_F(ThreadTest, coroutine_pending_call)
+{
+  lbot::Manager::Ptr manager = lbot::Manager::get();
+
+  std::shared_ptr<TestNode> node_a(manager->addNode<TestNode>("node_a"));
+  std::shared_ptr<TestNode> node_b(manager->addNode<TestNode>("node_b"));
+
+  Node::Server<TestMessageConv, TestMessageConv>::Ptr server = node_a->addServer<TestMessageConv, TestMessageConv>("service");
+  server->setHandler(handlerSlow);
+  Node::Client<TestMessageConv, TestMessageConv>::Ptr client = node_b->addClient<TestMessageConv, TestMessageConv>("service");
+
+  std::atomic<u64> response = 0;
+  slow_handler_flag = false;
+
+  {
+    lbot::Scheduler scheduler(1);
+    scheduler.spawn(callService(client.get(), &response));
+
+    // Destroy the scheduler while the request is still being handled.
+    slow_handler_flag.wait(false);
+  }
+
+  // The request completes after its coroutine has been destroyed and must not resume it.
+  client.reset();
+  ASSERT_EQ(response, 0);
+
+  server.reset();
+
+  node_a = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_a"));
+  node_b = std::shared_ptr<TestNode>();
+  ASSERT_NO_THROW(manager->removeNode("node_b"));
+}
+
 }  // namespace lbot::test
 }  // namespace labrat